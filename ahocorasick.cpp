@@ -0,0 +1,255 @@
+/***************************************************************
+# ahocorasick.cpp
+# Code implementing an Aho-Corasick automaton over the FlatTrie for line search
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of AhoCorasick class
+# 2026.10.2    15.10.2026   Optional SearchStats counters, compiled out when unused
+# 2026.10.3    15.10.2026   Ignore check is a bit test on the end-of-word node
+# 2026.10.4    15.10.2026   Reusable Scratch, only nodes hit are visited and reset
+# 2026.10.5    16.10.2026   Direction and letter code tables come from directions.h
+****************************************************************/
+
+#include "ahocorasick.h"
+#include "directions.h"
+#include <algorithm>
+
+using namespace std;
+
+// Marker for "no hit recorded yet" in the per-node first hit table
+static const uint64_t noHit = UINT64_MAX;
+
+// Build failure links breadth first, filling in the missing transitions as we go
+AhoCorasick::AhoCorasick(const FlatTrie& trie)
+    : sourceTrie(&trie), stats(nullptr)
+{
+    size_t nodes = trie.nodeCount();
+    delta.assign(nodes * 26, 0);
+    fail.assign(nodes, 0);
+    output.assign(nodes, 0);
+    depth.assign(nodes, 0);
+
+    vector<uint32_t> queue;
+    queue.reserve(nodes);
+
+    // Depth one nodes fail back to the root; missing root edges loop on the root
+    uint32_t root = trie.root();
+    for (int c = 0; c < 26; c++)
+    {
+        uint32_t child = trie.child(root, c);
+        delta[root * 26 + c] = child;
+        if (child != 0)
+        {
+            depth[child] = 1;
+            output[child] = trie.isEndOfWord(child) ? child : 0;
+            queue.push_back(child);
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        uint32_t node = queue[head];
+        for (int c = 0; c < 26; c++)
+        {
+            uint32_t child = trie.child(node, c);
+            if (child == 0)
+            {
+                delta[static_cast<size_t>(node) * 26 + c] = delta[static_cast<size_t>(fail[node]) * 26 + c];  // Borrow the failure node's transition
+                continue;
+            }
+
+            delta[static_cast<size_t>(node) * 26 + c] = child;
+            fail[child] = delta[static_cast<size_t>(fail[node]) * 26 + c];
+            depth[child] = depth[node] + 1;
+            output[child] = trie.isEndOfWord(child) ? child : output[fail[child]];
+            queue.push_back(child);
+        }
+    }
+}
+
+// Bytes held by the automaton tables
+size_t AhoCorasick::bytes() const
+{
+    return (delta.capacity() + fail.capacity() + output.capacity() + depth.capacity()) * sizeof(uint32_t);
+}
+
+// Attach counters to later searches, nullptr turns counting off
+void AhoCorasick::setStats(SearchStats* searchStats)
+{
+    stats = searchStats;
+}
+
+// Stream one line through the automaton and keep the earliest start of each word
+template <bool CountStats>
+void AhoCorasick::streamLine(const vector<vector<char>>& grid, int row, int col, int dirX, int dirY, int dir, int n, int cols, Scratch& scratch) const
+{
+    if (CountStats)
+    {
+        stats->walksStarted++;
+        stats->trieSteps += n;
+    }
+
+    uint32_t state = 0;
+    for (int p = 0; p < n; p++)
+    {
+        unsigned char index = letterCodes[static_cast<unsigned char>(grid[row + p * dirX][col + p * dirY])];
+        if (index >= 26)
+        {
+            state = 0;  // Not a letter, no word can span this cell
+            continue;
+        }
+
+        state = delta[static_cast<size_t>(state) * 26 + index];
+        for (uint32_t t = output[state]; t != 0; t = output[fail[t]])
+        {
+            // The word ends at position p, so it starts depth - 1 cells back along the line
+            int start = p - static_cast<int>(depth[t]) + 1;
+            uint64_t cell = static_cast<uint64_t>(row + start * dirX) * cols + (col + start * dirY);
+            uint64_t key = cell * 8 + dir;  // Same order as the DFS: row, column, then direction
+            uint64_t& first = scratch.firstHit[t];
+            if (key < first)
+            {
+                if (first == noHit)
+                {
+                    scratch.touched.push_back(t);
+                }
+                first = key;
+            }
+            if (CountStats) scratch.hitCount[t]++;
+        }
+    }
+}
+
+// Stream every row, column and diagonal of the grid in both directions
+template <bool CountStats>
+void AhoCorasick::streamGrid(const vector<vector<char>>& grid, int rows, int cols, Scratch& scratch) const
+{
+    // Each line is streamed forwards and backwards; the direction indices follow gridDx/gridDy
+    for (int i = 0; i < rows; i++)
+    {
+        streamLine<CountStats>(grid, i, 0, 0, 1, 3, cols, cols, scratch);          // Row, left to right
+        streamLine<CountStats>(grid, i, cols - 1, 0, -1, 7, cols, cols, scratch);  // Row, right to left
+    }
+    for (int j = 0; j < cols; j++)
+    {
+        streamLine<CountStats>(grid, 0, j, 1, 0, 5, rows, cols, scratch);          // Column, top to bottom
+        streamLine<CountStats>(grid, rows - 1, j, -1, 0, 1, rows, cols, scratch);  // Column, bottom to top
+    }
+    for (int s = 0; s < rows + cols - 1; s++)
+    {
+        // Diagonal running down and right, starting on the left or top edge
+        int row = max(0, rows - 1 - s);
+        int col = max(0, s - (rows - 1));
+        int n = min(rows - row, cols - col);
+        streamLine<CountStats>(grid, row, col, 1, 1, 4, n, cols, scratch);
+        streamLine<CountStats>(grid, row + n - 1, col + n - 1, -1, -1, 0, n, cols, scratch);
+
+        // Anti-diagonal running down and left, starting on the top or right edge
+        row = max(0, s - (cols - 1));
+        col = min(s, cols - 1);
+        n = min(rows - row, col + 1);
+        streamLine<CountStats>(grid, row, col, 1, -1, 6, n, cols, scratch);
+        streamLine<CountStats>(grid, row + n - 1, col - n + 1, -1, 1, 2, n, cols, scratch);
+    }
+}
+
+// Search with a scratch of its own, allocated for this call only
+vector<string> AhoCorasick::searchWords(const vector<vector<char>>& grid, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, int minWordLength) const
+{
+    Scratch scratch;
+    return searchWords(grid, locations, minWordLength, scratch);
+}
+
+// Stream every grid line in both directions, then report each word at its first DFS-order occurrence
+vector<string> AhoCorasick::searchWords(const vector<vector<char>>& grid, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, int minWordLength, Scratch& scratch) const
+{
+    vector<string> result;
+
+    if (grid.empty())
+    {
+        return result;
+    }
+
+    int rows = static_cast<int>(grid.size());
+    size_t width = grid[0].size();
+    for (const auto& row : grid)
+    {
+        width = min(width, row.size());  // Never step past the shortest row
+    }
+    int cols = static_cast<int>(width);
+    if (cols == 0)
+    {
+        return result;
+    }
+
+    // A new or resized scratch starts with every node unseen; after a search only the touched nodes are reset
+    if (scratch.firstHit.size() != fail.size())
+    {
+        scratch.firstHit.assign(fail.size(), noHit);
+        scratch.touched.clear();
+    }
+    if (stats)
+    {
+        scratch.hitCount.assign(fail.size(), 0);
+        streamGrid<true>(grid, rows, cols, scratch);
+    }
+    else
+    {
+        streamGrid<false>(grid, rows, cols, scratch);
+    }
+
+    // Keep the words that pass the length and ignore filters, in DFS order
+    uint32_t minDepth = static_cast<uint32_t>(max(minWordLength, 0));
+    vector<pair<uint64_t, uint32_t>> hits;
+    for (uint32_t t : scratch.touched)
+    {
+        uint64_t first = scratch.firstHit[t];
+        scratch.firstHit[t] = noHit;
+        if (depth[t] >= minDepth && !sourceTrie->isIgnored(t))
+        {
+            hits.push_back({first, t});
+        }
+        else if (stats)
+        {
+            stats->hits += scratch.hitCount[t];
+            if (depth[t] < minDepth) stats->rejectedMinLength += scratch.hitCount[t];
+            else stats->rejectedIgnored += scratch.hitCount[t];
+        }
+    }
+    scratch.touched.clear();
+    sort(hits.begin(), hits.end());
+
+    string word;
+    for (const auto& hit : hits)
+    {
+        uint64_t cell = hit.first / 8;
+        int dir = static_cast<int>(hit.first % 8);
+        int startX = static_cast<int>(cell / cols);
+        int startY = static_cast<int>(cell % cols);
+        int len = static_cast<int>(depth[hit.second]);
+
+        word.clear();
+        for (int k = 0; k < len; k++)
+        {
+            word += grid[startX + k * gridDx[dir]][startY + k * gridDy[dir]];
+        }
+        if (stats)
+        {
+            // Every match of the word after its first occurrence is a duplicate
+            stats->hits += scratch.hitCount[hit.second];
+            stats->accepted++;
+            stats->rejectedDuplicate += scratch.hitCount[hit.second] - 1;
+        }
+
+        int endX = startX + (len - 1) * gridDx[dir];
+        int endY = startY + (len - 1) * gridDy[dir];
+        result.push_back(word);
+        locations.push_back({word, {{startX + 1, startY + 1}, {endX + 1, endY + 1}}});  // Use 1-based coordinates for positions
+    }
+
+    return result;  // Return all unique found words
+}
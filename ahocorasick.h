@@ -0,0 +1,80 @@
+/***************************************************************
+# ahocorasick.h
+# Header for ahocorasick.cpp, defines the AhoCorasick line search engine
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of AhoCorasick class
+# 2026.10.2    15.10.2026   Added optional SearchStats counters
+# 2026.10.3    15.10.2026   Ignore words come from the FlatTrie ignore marks
+# 2026.10.4    15.10.2026   Per-caller Scratch so repeated searches skip the per-node allocation
+# 2026.10.5    16.10.2026   Dropped the letterIndex member for the shared letterCodes table
+****************************************************************/
+
+#ifndef AHOCORASICK_H
+#define AHOCORASICK_H
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include "flattrie.h"
+#include "searchstats.h"
+
+// AhoCorasick class definition.
+// Adds failure links and a full transition table on top of a loaded FlatTrie,
+// then streams every grid line (rows, columns and both diagonals, forwards and
+// backwards) through the automaton exactly once. Node indices match the FlatTrie,
+// so each terminal node still identifies one dictionary word.
+class AhoCorasick
+{
+public:
+    // Per-node working state of one search. Keeping one per thread and passing it to
+    // searchWords lets many grids share one automaton without reallocating it each time.
+    struct Scratch
+    {
+        std::vector<uint64_t> firstHit;  // Earliest start key of each node, noHit when unseen
+        std::vector<uint64_t> hitCount;  // Matches per node, only sized when counting stats
+        std::vector<uint32_t> touched;   // Nodes with a first hit in the current search
+    };
+
+    explicit AhoCorasick(const FlatTrie& trie);  // Build the automaton from a loaded FlatTrie
+
+    // Search the grid for words in the automaton, skipping words marked ignored in the FlatTrie
+    // and words shorter than minWordLength. Produces the same words, locations and ordering
+    // as GridSearch::searchWords given the same ignore list.
+    // The FlatTrie must outlive the automaton, since the ignore marks are read at search time.
+    std::vector<std::string> searchWords(const std::vector<std::vector<char>>& grid, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, int minWordLength) const;
+
+    // Same search using the caller's scratch; safe to run concurrently with one Scratch per thread
+    // as long as no stats are attached.
+    std::vector<std::string> searchWords(const std::vector<std::vector<char>>& grid, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, int minWordLength, Scratch& scratch) const;
+
+    size_t bytes() const;  // Bytes held by the automaton tables
+
+    // Count lines, characters streamed and hit outcomes of later searches into searchStats.
+    // Pass nullptr (the default) to search without any counting overhead.
+    void setStats(SearchStats* searchStats);
+
+private:
+    // Stream one line of n cells, starting at (row, col) and stepping (dirX, dirY),
+    // recording the earliest start of every word that ends on the line.
+    // The CountStats = true copy also counts every match per node into scratch.hitCount.
+    template <bool CountStats>
+    void streamLine(const std::vector<std::vector<char>>& grid, int row, int col, int dirX, int dirY, int dir, int n, int cols, Scratch& scratch) const;
+
+    // Stream every row, column and diagonal of the grid in both directions
+    template <bool CountStats>
+    void streamGrid(const std::vector<std::vector<char>>& grid, int rows, int cols, Scratch& scratch) const;
+
+    const FlatTrie* sourceTrie;  // Source trie, consulted for ignore marks
+    std::vector<uint32_t> delta;   // Full transition table, 26 entries per node
+    std::vector<uint32_t> fail;    // Failure link of each node
+    std::vector<uint32_t> output;  // Nearest end-of-word node on the failure chain (itself included), 0 for none
+    std::vector<uint32_t> depth;   // Length of the prefix each node spells
+    SearchStats* stats;  // Counters for the current search, or nullptr
+};
+
+#endif // AHOCORASICK_H
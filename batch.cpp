@@ -0,0 +1,405 @@
+/***************************************************************
+# batch.cpp
+# Code implementing batch mode, many grids searched against one loaded dictionary
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of batch mode
+# 2026.10.2    15.10.2026   searchGridRecord shared with the socket server
+# 2026.10.3    15.10.2026   Boggle engine searches each grid along free paths
+# 2026.10.4    16.10.2026   First-only pruning passed on to each worker's searches
+# 2026.10.5    16.10.2026   Ragged grids rejected with an error record, grids taken at most a window ahead
+# 2026.10.6    16.10.2026   Hit end cells use the shared gridDx/gridDy
+# 2026.10.7    16.10.2026   Records escape names and words through the shared appendJSONString
+****************************************************************/
+
+#include "batch.h"
+#include "directions.h"
+#include "resultwriter.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+using namespace std;
+
+// Text with leading and trailing whitespace removed
+static string trimmed(const char* begin, const char* end)
+{
+    while (begin != end && isspace(static_cast<unsigned char>(*begin))) begin++;
+    while (end != begin && isspace(static_cast<unsigned char>(end[-1]))) end--;
+    return string(begin, end);
+}
+
+// True when a file name ends in .csv, in any letter case
+static bool hasCSVExtension(const string& name)
+{
+    if (name.size() < 4)
+    {
+        return false;
+    }
+    string ext = name.substr(name.size() - 4);
+    transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".csv";
+}
+
+// Names of the .csv files in a directory, sorted; returns false if it cannot be listed
+static bool listCSVFiles(const string& dir, vector<string>& names)
+{
+#ifdef _WIN32
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA((dir + "\\*").c_str(), &entry);
+    if (find == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    do
+    {
+        if (!(entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && hasCSVExtension(entry.cFileName))
+        {
+            names.push_back(entry.cFileName);
+        }
+    } while (FindNextFileA(find, &entry));
+    FindClose(find);
+#else
+    DIR* handle = opendir(dir.c_str());
+    if (!handle)
+    {
+        return false;
+    }
+    while (dirent* entry = readdir(handle))
+    {
+        if (entry->d_name[0] != '.' && hasCSVExtension(entry->d_name))
+        {
+            names.push_back(entry->d_name);
+        }
+    }
+    closedir(handle);
+#endif
+    sort(names.begin(), names.end());
+    return true;
+}
+
+// Directory part of a path including the trailing separator, empty if there is none
+static string directoryOf(const string& path)
+{
+    size_t slash = path.find_last_of("/\\");
+    return slash == string::npos ? string() : path.substr(0, slash + 1);
+}
+
+// True for paths that should not be joined to the manifest's directory
+static bool isAbsolutePath(const string& path)
+{
+    return !path.empty() && (path[0] == '/' || path[0] == '\\' || (path.size() > 1 && path[1] == ':'));
+}
+
+// Constructor, no source open yet
+GridSource::GridSource()
+    : nextFile(0), multi(false), multiCount(0)
+{
+}
+
+// Collect the grid files of a directory or manifest, or map a multi-grid file
+bool GridSource::open(const string& path, const string& kind)
+{
+    files.clear();
+    nextFile = 0;
+    multi = false;
+    pendingName.clear();
+    multiCount = 0;
+
+    if (kind == "dir")
+    {
+        vector<string> names;
+        if (!listCSVFiles(path, names))
+        {
+            cerr << "Error: Could not list grid directory " << path << endl;
+            return false;
+        }
+        string prefix = path.empty() || path.back() == '/' || path.back() == '\\' ? path : path + "/";
+        for (const auto& name : names)
+        {
+            files.push_back(prefix + name);
+        }
+        return true;
+    }
+
+    if (kind == "manifest")
+    {
+        CSVReader manifest;
+        if (!manifest.open(path))
+        {
+            cerr << "Error: Could not open grid manifest " << path << endl;
+            return false;
+        }
+
+        // One grid file per line; blank lines and lines starting with # are skipped
+        string base = directoryOf(path);
+        while (manifest.nextLine())
+        {
+            string file = trimmed(manifest.line(), manifest.line() + manifest.lineSize());
+            if (!file.empty() && file[0] != '#')
+            {
+                files.push_back(isAbsolutePath(file) ? file : base + file);
+            }
+        }
+        return true;
+    }
+
+    if (kind == "multi")
+    {
+        if (!reader.open(path))
+        {
+            cerr << "Error: Could not open multi-grid file " << path << endl;
+            return false;
+        }
+        multi = true;
+        return true;
+    }
+
+    cerr << "Error: Unknown batch source " << kind << ". Use dir, manifest or multi." << endl;
+    return false;
+}
+
+// Read the next grid file, or the rows up to the next separator line of a multi-grid file
+bool GridSource::next(size_t& index, string& name, vector<vector<char>>& grid, size_t& bytes)
+{
+    grid.clear();
+    bytes = 0;
+
+    unique_lock<mutex> guard(lock);
+    if (!multi)
+    {
+        if (nextFile == files.size())
+        {
+            return false;
+        }
+        index = nextFile++;
+        name = files[index];
+        guard.unlock();  // Only claiming the file needs the lock, other threads can read theirs meanwhile
+
+        grid = readCSVFile(name, &bytes);
+        return true;
+    }
+
+    index = multiCount;
+    name = pendingName;
+    size_t width = 0;
+    while (reader.nextLine())
+    {
+        const char* line = reader.line();
+        if (reader.lineSize() >= 3 && memcmp(line, "---", 3) == 0)
+        {
+            string label = trimmed(line + 3, line + reader.lineSize());
+            if (!grid.empty())
+            {
+                pendingName = label;  // Names the grid after this one
+                multiCount++;
+                return true;
+            }
+            name = label;  // Separator before any rows, it names this grid
+            continue;
+        }
+
+        vector<char> row;
+        row.reserve(width);
+        reader.readCells(row);
+        bytes += reader.lineSize() + 1;
+        if (!row.empty())
+        {
+            width = row.size();
+            grid.push_back(move(row));
+        }
+    }
+
+    pendingName.clear();
+    if (grid.empty())
+    {
+        return false;
+    }
+    multiCount++;
+    return true;
+}
+
+// Append one found word and its 1-based start and end to a record
+static void appendWord(string& out, bool first, const char* word, size_t length, int startX, int startY, int endX, int endY)
+{
+    out += first ? "{\"word\": " : ", {\"word\": ";
+    appendJSONString(out, word, length);
+    out += ", \"start\": [" + to_string(startX) + ", " + to_string(startY) + "], \"end\": [" + to_string(endX) + ", " + to_string(endY) + "]}";
+}
+
+// Why a grid cannot be searched, or nullptr when it can
+const char* gridError(const vector<vector<char>>& grid)
+{
+    if (grid.empty())
+    {
+        return "grid could not be read or is empty";
+    }
+    for (const auto& row : grid)
+    {
+        if (row.size() != grid[0].size())
+        {
+            return "grid rows are not all the same width";
+        }
+    }
+    return nullptr;
+}
+
+// Search one grid with the configured engine and build its JSON record, returns the words found
+size_t searchGridRecord(SearchWorker& worker, const BatchConfig& config, Trie* trie, const FlatTrie* flatTrie, const AhoCorasick* automaton, const set<string>& ignoreWords, size_t index, const string& name, vector<vector<char>>& grid)
+{
+    string& out = worker.record;
+    out = "{\"index\": " + to_string(index) + ", \"grid\": ";
+    appendJSONString(out, name.data(), name.size());
+
+    const char* error = gridError(grid);
+    if (error)
+    {
+        out += ", \"error\": \"";
+        out += error;
+        out += "\"}\n";
+        return 0;
+    }
+
+    worker.locations.clear();
+    worker.allResults.hits.clear();
+    worker.gridSearch.setFirstOnly(config.firstOnly);
+    worker.lineScanner.setFirstOnly(config.firstOnly);
+    if (config.engine == "scan" && config.allOccurrences)
+    {
+        worker.lineScanner.searchAll(grid, *flatTrie, worker.allResults, config.minWordLength);
+    }
+    else if (config.engine == "scan")
+    {
+        worker.lineScanner.searchWords(grid, *flatTrie, worker.locations, config.minWordLength);
+    }
+    else if (config.engine == "ac")
+    {
+        automaton->searchWords(grid, worker.locations, config.minWordLength, worker.acScratch);
+    }
+    else if (config.engine == "boggle")
+    {
+        worker.boggle.searchWords(grid, *flatTrie, worker.locations, config.minWordLength, config.maxPath);
+    }
+    else if (config.engine == "flat")
+    {
+        worker.gridSearch.searchWords(grid, flatTrie, worker.locations, ignoreWords, config.minWordLength);
+    }
+    else
+    {
+        worker.gridSearch.searchWords(grid, trie, worker.locations, ignoreWords, config.minWordLength);
+    }
+
+    size_t found = worker.locations.size() + worker.allResults.hits.size();
+    out += ", \"rows\": " + to_string(grid.size()) + ", \"cols\": " + to_string(grid[0].size()) + ", \"found\": " + to_string(found) + ", \"words\": [";
+
+    bool first = true;
+    for (const auto& entry : worker.locations)
+    {
+        appendWord(out, first, entry.first.data(), entry.first.size(), entry.second.first.first, entry.second.first.second, entry.second.second.first, entry.second.second.second);
+        first = false;
+    }
+    for (const auto& hit : worker.allResults.hits)
+    {
+        int endX = hit.row + (hit.length - 1) * gridDx[hit.dir];
+        int endY = hit.col + (hit.length - 1) * gridDy[hit.dir];
+        appendWord(out, first, worker.allResults.words.data(hit.wordId), hit.length, hit.row + 1, hit.col + 1, endX + 1, endY + 1);
+        first = false;
+    }
+    out += "]}\n";
+    return found;
+}
+
+// Search every grid of the batch on a pool of threads, writing the records in source order
+BatchSummary runBatch(GridSource& source, const BatchConfig& config, Trie* trie, const FlatTrie* flatTrie, const AhoCorasick* automaton, const set<string>& ignoreWords, ostream& out)
+{
+    BatchSummary summary;
+    mutex outputMutex;          // Guards the summary, the window and the records waiting to be written
+    condition_variable written; // Signalled when nextToWrite moves on
+    size_t nextToWrite = 0;     // Index of the next record to write
+    size_t taken = 0;           // Grids workers have been let take from the source
+    map<size_t, string> ready;  // Records finished ahead of nextToWrite
+    int threads = max(1, config.threads);
+    size_t window = batchWindow * threads;  // Grids that may be taken ahead of nextToWrite
+
+    auto work = [&]()
+    {
+        SearchWorker worker;
+        string name;
+        vector<vector<char>> grid;
+        size_t bytes = 0;
+
+        for (;;)
+        {
+            // Wait for room in the window. The source hands out indices in the order grids are
+            // taken, so the grid taken next is less than window ahead of nextToWrite.
+            {
+                unique_lock<mutex> lock(outputMutex);
+                written.wait(lock, [&]() { return taken < nextToWrite + window; });
+                taken++;
+            }
+
+            size_t index;
+            if (!source.next(index, name, grid, bytes))
+            {
+                return;
+            }
+
+            size_t found = searchGridRecord(worker, config, trie, flatTrie, automaton, ignoreWords, index, name, grid);
+
+            lock_guard<mutex> lock(outputMutex);
+            summary.grids++;
+            summary.failed += gridError(grid) ? 1 : 0;
+            summary.found += found;
+            summary.gridBytes += bytes;
+
+            if (index != nextToWrite)
+            {
+                ready[index].swap(worker.record);  // An earlier grid is still being searched
+                continue;
+            }
+
+            // Write this record and any later ones that were waiting on it
+            out << worker.record;
+            nextToWrite++;
+            for (auto it = ready.find(nextToWrite); it != ready.end(); it = ready.find(nextToWrite))
+            {
+                out << it->second;
+                ready.erase(it);
+                nextToWrite++;
+            }
+            out.flush();
+            written.notify_all();
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++)
+    {
+        pool.emplace_back(work);
+    }
+    work();  // The calling thread searches grids too
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+
+    return summary;
+}
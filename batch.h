@@ -0,0 +1,116 @@
+/***************************************************************
+# batch.h
+# Header for batch.cpp, defines the GridSource and the batch grid runner
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of batch mode
+# 2026.10.2    15.10.2026   searchGridRecord shared with the socket server
+# 2026.10.3    15.10.2026   Boggle engine in each SearchWorker, path cap in BatchConfig
+# 2026.10.4    16.10.2026   First-only switch in BatchConfig
+# 2026.10.5    16.10.2026   Added gridError, ragged grids are rejected before any engine runs
+****************************************************************/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+#include "csvreader.h"
+#include "trie.h"
+#include "flattrie.h"
+#include "ahocorasick.h"
+#include "gridsearch.h"
+#include "linescan.h"
+#include "boggle.h"
+#include "wordtable.h"
+
+// GridSource class definition.
+// Hands out the grids of a batch one at a time, from one of three kinds of source:
+//   dir       every .csv file in a directory, in name order
+//   manifest  a text file listing one grid file per line, relative to the manifest
+//   multi     one file holding many grids, each started by a separator line
+//             beginning with "---"; any text after the dashes names the grid
+// next() may be called from several threads; grid files are read in parallel,
+// while a multi-grid file is read one grid at a time.
+class GridSource
+{
+public:
+    GridSource();
+
+    // Open a source of the given kind, returns false if it cannot be read
+    bool open(const std::string& path, const std::string& kind);
+
+    // Read the next grid and its position in the source, returns false when the source is exhausted.
+    // A grid file that cannot be read comes back with an empty grid.
+    bool next(size_t& index, std::string& name, std::vector<std::vector<char>>& grid, size_t& bytes);
+
+private:
+    std::vector<std::string> files;  // Grid files still to read, for dir and manifest sources
+    size_t nextFile;                 // Index of the next entry in files
+    bool multi;                      // True for a multi-grid file
+    CSVReader reader;                // Multi-grid file being read
+    std::string pendingName;         // Name from the last separator line of a multi-grid file
+    size_t multiCount;               // Grids read so far from the multi-grid file
+    std::mutex lock;                 // Guards everything above while next() runs
+};
+
+// Grids per thread that may be taken ahead of the next record to write
+static const size_t batchWindow = 4;
+
+// Settings for one batch run
+struct BatchConfig
+{
+    std::string engine = "dfs";   // Search engine, as for -e
+    int minWordLength = 3;        // Minimum reported word length
+    int threads = 1;              // Grids searched at the same time
+    bool allOccurrences = false;  // Report every occurrence (scan engine only)
+    int maxPath = 0;              // Longest boggle path, 0 for no cap
+    bool firstOnly = false;       // Prune subtrees with every word found (dfs, flat and scan)
+};
+
+// Totals over a batch run
+struct BatchSummary
+{
+    size_t grids = 0;      // Grids searched
+    size_t failed = 0;     // Grids that could not be read or searched
+    size_t found = 0;      // Words reported over all grids
+    size_t gridBytes = 0;  // Grid CSV bytes read
+};
+
+// Engines and scratch owned by one search thread, reused for every grid it searches
+struct SearchWorker
+{
+    GridSearch gridSearch;
+    LineScanner lineScanner;
+    BoggleSearch boggle;
+    AhoCorasick::Scratch acScratch;
+    SearchResults allResults;
+    std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>> locations;
+    std::string record;  // JSON record of the last grid searched, newline terminated
+};
+
+// Why a grid cannot be searched, or nullptr when it can. The engines index every row up to
+// the first row's width, so a grid must have at least one row and every row the same width.
+const char* gridError(const std::vector<std::vector<char>>& grid);
+
+// Search one grid with the configured engine and write its JSON record to worker.record.
+// Returns the number of words found; a grid gridError rejects gets a record with an error field.
+size_t searchGridRecord(SearchWorker& worker, const BatchConfig& config, Trie* trie, const FlatTrie* flatTrie, const AhoCorasick* automaton, const std::set<std::string>& ignoreWords, size_t index, const std::string& name, std::vector<std::vector<char>>& grid);
+
+// Search every grid from source and write one JSON object per grid, one per line, to out.
+// Grids are searched on config.threads threads, but records come out in source order. No
+// worker takes a grid more than batchWindow grids per thread ahead of the next record to
+// write, so one slow grid cannot make the others pile up finished records in memory.
+// The trie matching the engine must be loaded, automaton must be built for the ac engine,
+// and ignore words must already be marked in flatTrie for the FlatTrie engines.
+BatchSummary runBatch(GridSource& source, const BatchConfig& config, Trie* trie, const FlatTrie* flatTrie, const AhoCorasick* automaton, const std::set<std::string>& ignoreWords, std::ostream& out);
+
+#endif // BATCH_H
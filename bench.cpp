@@ -0,0 +1,1183 @@
+/***************************************************************
+# bench.cpp
+# Benchmark harness for GridLex, times each phase over repeated runs
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial version, search suite and workload generator
+# 2026.10.2    15.10.2026   Scan and ac engines read ignore marks from the FlatTrie
+# 2026.10.3    15.10.2026   Added --all to time the all-occurrences scan
+# 2026.10.4    15.10.2026   Report CSV load throughput in MB/s
+# 2026.10.5    15.10.2026   Added the layout suite, nested rows against PackedGrid per direction
+# 2026.10.6    15.10.2026   Added --prefilter to pick or disable the bigram prefilter kernel
+# 2026.10.7    15.10.2026   Added the edit suite, SearchSession cell updates against full searches
+# 2026.10.8    15.10.2026   Added the dict suite, Trie, FlatTrie and Dawg build time and size, and --suffix-share
+# 2026.10.9    15.10.2026   Added the boggle suite, free-path search over square boards of several sizes
+# 2026.10.10   16.10.2026   Added the fuzzy suite, FuzzyScanner at each mismatch budget against the exact scan
+# 2026.10.11   16.10.2026   Added the output suite and --format; the search suite writes through a ResultWriter
+# 2026.10.12   16.10.2026   Added --load-threads for the parallel Trie load of the dfs engine
+# 2026.10.13   16.10.2026   Direction and letter code tables come from directions.h
+****************************************************************/
+
+#include "gridsearch.h"
+#include "trie.h"
+#include "flattrie.h"
+#include "linescan.h"
+#include "ahocorasick.h"
+#include "wordtable.h"
+#include "workload.h"
+#include "packedgrid.h"
+#include "bigramfilter.h"
+#include "searchsession.h"
+#include "dawg.h"
+#include "boggle.h"
+#include "fuzzy.h"
+#include "resultwriter.h"
+#include "directions.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Options shared by every benchmark suite
+struct BenchOptions
+{
+    string suite = "search";     // Which benchmark to run
+    int rows = 1000;             // Grid rows
+    int cols = 1000;             // Grid columns
+    size_t words = 100000;       // Dictionary size
+    double prefixShare = 0.5;    // Chance a word reuses an earlier word's prefix
+    double suffixShare = 0;      // Chance a word ends on a common English suffix
+    int minLength = 3;           // Shortest generated word
+    int maxLength = 12;          // Longest generated word
+    size_t plant = 0;            // Words planted in the grid, 0 picks one per 64 cells
+    uint64_t seed = 1;           // Workload seed
+    int runs = 5;                // Timed runs
+    int warmup = 1;              // Untimed runs before the timed ones
+    string engine = "scan";      // Search engine, as for GridLex -e
+    int threads = 1;             // Search threads for the scan engine
+    int loadThreads = 1;         // Dictionary build threads for the dfs engine, as for GridLex --load-threads
+    int minWordLength = 3;       // Minimum reported word length, as for GridLex -n
+    bool compiled = false;       // Load the dictionary from a compiled file instead of CSV
+    bool all = false;            // Report every occurrence, as for GridLex -a
+    string workDir = ".";        // Where the generated CSV files and results are written
+    string prefilter = "auto";   // Bigram prefilter kernel: auto, avx2, ssse3, scalar or off
+    int edits = 1000;            // Cell edits timed by the edit suite
+    string sizes = "4,8,16,32,64,100";  // Board sizes for the boggle suite
+    int maxPath = 0;             // Longest boggle path, 0 for no cap
+    int maxMismatches = 2;       // Largest mismatch budget timed by the fuzzy suite
+    string format = "text";      // Output format of the search suite, as for GridLex --format
+};
+
+// Display help information for the benchmark harness
+static void displayHelp()
+{
+    cout << "Usage: ./gridlex_bench [suite] [options]\n"
+         << "Suites:\n"
+         << "  search                       Time dictionary load, grid load, search and output (default)\n"
+         << "  generate                     Only write the generated grid and words CSV files\n"
+         << "  layout                       Time trie walks and full line streams in each of the 8 directions,\n"
+         << "                               over nested row vectors and over the PackedGrid copies\n"
+         << "  dict                         Build the pointer Trie, FlatTrie and Dawg from one word list and compare\n"
+         << "                               build time, bytes per word and DFS search time\n"
+         << "  boggle                       Time the free-path boggle search on square boards of each --sizes size,\n"
+         << "                               with and without exhausted subtree pruning\n"
+         << "  fuzzy                        Time the FuzzyScanner with 0 to -k mismatches against the exact scan\n"
+         << "                               of the same grid, and check its 0 mismatch output matches the scan\n"
+         << "  output                       Time writing one search's results in each --format against the old\n"
+         << "                               line-by-line output flushed after every line, per million hits\n"
+         << "  edit                         Time single cell edits in a SearchSession against a full search,\n"
+         << "                               and check the session's words against a full search afterwards\n"
+         << "Options:\n"
+         << "  --rows <n>                   Grid rows (default: 1000)\n"
+         << "  --cols <n>                   Grid columns (default: 1000)\n"
+         << "  --words <n>                  Dictionary size (default: 100000)\n"
+         << "  --prefix-share <f>           Chance 0-1 that a word reuses an earlier prefix (default: 0.5)\n"
+         << "  --suffix-share <f>           Chance 0-1 that a word ends on a common English suffix (default: 0)\n"
+         << "  --min-length <n>             Shortest generated word (default: 3)\n"
+         << "  --max-length <n>             Longest generated word (default: 12)\n"
+         << "  --plant <n>                  Dictionary words planted in the grid (default: one per 64 cells)\n"
+         << "  --seed <n>                   Workload seed (default: 1)\n"
+         << "  --runs <n>                   Timed runs (default: 5)\n"
+         << "  --warmup <n>                 Untimed warm-up runs (default: 1)\n"
+         << "  -e <engine>                  dfs, flat, scan or ac (default: scan)\n"
+         << "  -j <threads>                 Search threads for the scan engine and the boggle suite (default: 1)\n"
+         << "  --load-threads <n>           Threads building the dfs engine's Trie, 0 for all cores (default: 1)\n"
+         << "  -n <min_word_length>         Minimum reported word length (default: 3)\n"
+         << "  --compiled                   Load the dictionary from a compiled file\n"
+         << "  --all                        Report every occurrence of each word (scan engine only)\n"
+         << "  --work-dir <dir>             Directory for generated files (default: .)\n"
+         << "  --edits <n>                  Cell edits made by the edit suite (default: 1000)\n"
+         << "  --sizes <list>               Comma separated board sizes for the boggle suite (default: 4,8,16,32,64,100)\n"
+         << "  --max-path <n>               Longest boggle path, 0 for no cap (default: 0)\n"
+         << "  -k <mismatches>              Largest mismatch budget for the fuzzy suite (default: 2)\n"
+         << "  --format <format>            Output format of the search suite: text, json, csv or bin (default: text)\n"
+         << "  --prefilter <kernel>         Bigram prefilter kernel: auto, avx2, ssse3, scalar or off (default: auto)\n"
+         << "Results are printed as one JSON object on stdout.\n"
+         << endl;
+}
+
+// Parse the command line into options, returns false on a bad argument
+static bool parseOptions(int argc, char* argv[], BenchOptions& options)
+{
+    int i = 1;
+    if (i < argc && argv[i][0] != '-')
+    {
+        options.suite = argv[i++];
+    }
+
+    for (; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "--compiled")
+        {
+            options.compiled = true;
+            continue;
+        }
+        if (arg == "--all")
+        {
+            options.all = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            cerr << "Error: No value specified after " << arg << "." << endl;
+            return false;
+        }
+
+        string value = argv[++i];
+        try
+        {
+            if (arg == "--rows") options.rows = stoi(value);
+            else if (arg == "--cols") options.cols = stoi(value);
+            else if (arg == "--words") options.words = static_cast<size_t>(stoull(value));
+            else if (arg == "--prefix-share") options.prefixShare = stod(value);
+            else if (arg == "--suffix-share") options.suffixShare = stod(value);
+            else if (arg == "--min-length") options.minLength = stoi(value);
+            else if (arg == "--max-length") options.maxLength = stoi(value);
+            else if (arg == "--plant") options.plant = static_cast<size_t>(stoull(value));
+            else if (arg == "--seed") options.seed = stoull(value);
+            else if (arg == "--runs") options.runs = stoi(value);
+            else if (arg == "--warmup") options.warmup = stoi(value);
+            else if (arg == "-e") options.engine = value;
+            else if (arg == "-j") options.threads = stoi(value);
+            else if (arg == "--load-threads") options.loadThreads = stoi(value);
+            else if (arg == "-n") options.minWordLength = stoi(value);
+            else if (arg == "--work-dir") options.workDir = value;
+            else if (arg == "--prefilter") options.prefilter = value;
+            else if (arg == "--edits") options.edits = stoi(value);
+            else if (arg == "--sizes") options.sizes = value;
+            else if (arg == "--max-path") options.maxPath = stoi(value);
+            else if (arg == "-k") options.maxMismatches = stoi(value);
+            else if (arg == "--format") options.format = value;
+            else
+            {
+                cerr << "Error: Unknown option " << arg << endl;
+                return false;
+            }
+        }
+        catch (const exception& e)
+        {
+            cerr << "Error: Invalid value " << value << " for " << arg << "." << endl;
+            return false;
+        }
+    }
+
+    if (options.rows <= 0 || options.cols <= 0 || options.runs <= 0)
+    {
+        cerr << "Error: --rows, --cols and --runs must be positive." << endl;
+        return false;
+    }
+    if (options.engine != "dfs" && options.engine != "flat" && options.engine != "scan" && options.engine != "ac")
+    {
+        cerr << "Error: Unknown search engine " << options.engine << ". Use dfs, flat, scan or ac." << endl;
+        return false;
+    }
+    if (options.loadThreads != 1 && options.engine != "dfs")
+    {
+        cerr << "Error: --load-threads is only supported by the dfs engine." << endl;
+        return false;
+    }
+    if (options.all && options.engine != "scan")
+    {
+        cerr << "Error: --all is only supported by the scan engine." << endl;
+        return false;
+    }
+
+    OutputFormat format;
+    if (!parseOutputFormat(options.format, format))
+    {
+        cerr << "Error: Unknown output format " << options.format << ". Use text, json, csv or bin." << endl;
+        return false;
+    }
+
+    BigramFilter::Kernel kernels[] = {BigramFilter::Auto, BigramFilter::Avx2, BigramFilter::Ssse3, BigramFilter::Scalar, BigramFilter::Off};
+    bool known = false;
+    for (BigramFilter::Kernel kernel : kernels)
+    {
+        if (options.prefilter == BigramFilter::kernelName(kernel))
+        {
+            known = true;
+            if (!BigramFilter::setKernel(kernel))
+            {
+                cerr << "Error: This CPU cannot run the " << options.prefilter << " prefilter kernel." << endl;
+                return false;
+            }
+        }
+    }
+    if (!known)
+    {
+        cerr << "Error: Unknown prefilter kernel " << options.prefilter << ". Use auto, avx2, ssse3, scalar or off." << endl;
+        return false;
+    }
+    return true;
+}
+
+// Milliseconds elapsed since start
+static double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Value at quantile q (0 to 1) of a sample, nearest rank
+static double quantile(vector<double> samples, double q)
+{
+    sort(samples.begin(), samples.end());
+    size_t rank = static_cast<size_t>(q * samples.size() + 0.999999);
+    rank = min(max(rank, static_cast<size_t>(1)), samples.size());
+    return samples[rank - 1];
+}
+
+// JSON summary of one phase's samples
+static string summarise(const vector<double>& samples)
+{
+    ostringstream out;
+    double total = 0;
+    for (double s : samples)
+    {
+        total += s;
+    }
+    out << "{\"median_ms\": " << quantile(samples, 0.5)
+        << ", \"p95_ms\": " << quantile(samples, 0.95)
+        << ", \"min_ms\": " << *min_element(samples.begin(), samples.end())
+        << ", \"max_ms\": " << *max_element(samples.begin(), samples.end())
+        << ", \"mean_ms\": " << total / samples.size() << "}";
+    return out.str();
+}
+
+// Generate the workload and write it to the work directory
+static bool writeWorkload(const BenchOptions& options, string& gridFile, string& wordsFile, size_t& wordCount)
+{
+    vector<string> words = generateWords(options.words, options.prefixShare, options.minLength, options.maxLength, options.seed, options.suffixShare);
+    size_t plant = options.plant > 0 ? options.plant : static_cast<size_t>(options.rows) * options.cols / 64;
+    vector<vector<char>> grid = generateGrid(options.rows, options.cols, words, plant, options.seed + 1);
+
+    gridFile = options.workDir + "/bench_grid.csv";
+    wordsFile = options.workDir + "/bench_words.csv";
+    wordCount = words.size();
+    return writeGridCSV(gridFile, grid) && writeWordsCSV(wordsFile, words);
+}
+
+// Time the four phases of a normal GridLex run, repeated options.runs times
+static int runSearchSuite(const BenchOptions& options)
+{
+    string gridFile;
+    string wordsFile;
+    size_t wordCount = 0;
+    if (!writeWorkload(options, gridFile, wordsFile, wordCount))
+    {
+        return 1;
+    }
+
+    bool flat = options.engine != "dfs";
+    string dictFile = wordsFile;
+    if (options.compiled)
+    {
+        if (!flat)
+        {
+            cerr << "Error: --compiled needs a FlatTrie engine (flat, scan or ac)." << endl;
+            return 1;
+        }
+        FlatTrie compiledTrie;
+        loadWordsFromCSVFile(wordsFile, compiledTrie);
+        dictFile = options.workDir + "/bench_words.gld";
+        if (!compiledTrie.saveCompiled(dictFile))
+        {
+            return 1;
+        }
+    }
+
+    const char* phaseNames[] = {"dict_load", "grid_load", "search", "output"};
+    map<string, vector<double>> samples;
+    size_t found = 0;
+    size_t trieNodes = 0;
+    size_t trieBytes = 0;
+    size_t dictBytes = 0;  // CSV bytes parsed per dictionary load, 0 for a compiled dictionary
+    size_t gridBytes = 0;  // CSV bytes parsed per grid load
+    OutputFormat format = OutputFormat::Text;
+    parseOutputFormat(options.format, format);
+    string resultsFile = options.workDir + "/bench_results." + (format == OutputFormat::Text ? "txt" : options.format);
+
+    for (int run = 0; run < options.warmup + options.runs; run++)
+    {
+        bool timed = run >= options.warmup;
+        Trie trie;
+        FlatTrie flatTrie;
+        set<string> ignoreWords;
+        vector<pair<string, pair<pair<int, int>, pair<int, int>>>> locations;
+
+        auto start = chrono::steady_clock::now();
+        if (options.compiled)
+        {
+            if (!flatTrie.loadCompiled(dictFile))
+            {
+                return 1;
+            }
+        }
+        else if (flat)
+        {
+            loadWordsFromCSVFile(dictFile, flatTrie, &dictBytes);
+        }
+        else if (options.loadThreads != 1)
+        {
+            loadWordsFromCSVFile(dictFile, trie, options.loadThreads, &dictBytes);
+        }
+        else
+        {
+            loadWordsFromCSVFile(dictFile, trie, &dictBytes);
+        }
+        double dictMs = elapsedMs(start);
+
+        start = chrono::steady_clock::now();
+        vector<vector<char>> grid = readCSVFile(gridFile, &gridBytes);
+        double gridMs = elapsedMs(start);
+
+        start = chrono::steady_clock::now();
+        vector<string> words;
+        SearchResults all;
+        if (options.engine == "scan" && options.all)
+        {
+            LineScanner scanner;
+            scanner.searchAll(grid, flatTrie, all, options.minWordLength, options.threads);
+        }
+        else if (options.engine == "scan")
+        {
+            LineScanner scanner;
+            words = scanner.searchWords(grid, flatTrie, locations, options.minWordLength, options.threads);
+        }
+        else if (options.engine == "ac")
+        {
+            AhoCorasick automaton(flatTrie);
+            words = automaton.searchWords(grid, locations, options.minWordLength);
+        }
+        else if (options.engine == "flat")
+        {
+            GridSearch gridSearch;
+            words = gridSearch.searchWords(grid, &flatTrie, locations, ignoreWords, options.minWordLength);
+        }
+        else
+        {
+            GridSearch gridSearch;
+            words = gridSearch.searchWords(grid, &trie, locations, ignoreWords, options.minWordLength);
+        }
+        double searchMs = elapsedMs(start);
+
+        // Same output as GridLex writes, to a file instead of the console
+        start = chrono::steady_clock::now();
+        {
+            ofstream out(resultsFile, ios::trunc | ios::binary);
+            ResultWriter writer(out, format);
+            if (options.all)
+            {
+                writer.write(all);
+            }
+            else
+            {
+                writer.write(locations, vector<int>());
+            }
+        }
+        double outputMs = elapsedMs(start);
+
+        if (timed)
+        {
+            samples["dict_load"].push_back(dictMs);
+            samples["grid_load"].push_back(gridMs);
+            samples["search"].push_back(searchMs);
+            samples["output"].push_back(outputMs);
+        }
+        found = options.all ? all.hits.size() : words.size();
+        trieNodes = flat ? flatTrie.nodeCount() : 0;
+        trieBytes = flat ? flatTrie.bytes() : 0;
+    }
+
+    cout << "{\"suite\": \"search\", \"engine\": \"" << options.engine << "\", \"threads\": " << options.threads
+         << ", \"load_threads\": " << options.loadThreads << ", \"prefilter\": \"" << BigramFilter::kernelName(BigramFilter::activeKernel()) << "\""
+         << ", \"rows\": " << options.rows << ", \"cols\": " << options.cols
+         << ", \"words\": " << wordCount << ", \"prefix_share\": " << options.prefixShare << ", \"suffix_share\": " << options.suffixShare
+         << ", \"seed\": " << options.seed << ", \"runs\": " << options.runs
+         << ", \"compiled\": " << (options.compiled ? "true" : "false") << ", \"all\": " << (options.all ? "true" : "false")
+         << ", \"format\": \"" << options.format << "\", \"found\": " << found << ", \"trie_nodes\": " << trieNodes << ", \"trie_bytes\": " << trieBytes
+         << ", \"phases\": {";
+    for (size_t p = 0; p < 4; p++)
+    {
+        cout << (p > 0 ? ", " : "") << "\"" << phaseNames[p] << "\": " << summarise(samples[phaseNames[p]]);
+    }
+    cout << "}";
+
+    // Load throughput at the median time, counting the CSV bytes parsed
+    double dictMedian = quantile(samples["dict_load"], 0.5);
+    double gridMedian = quantile(samples["grid_load"], 0.5);
+    cout << ", \"throughput_mb_s\": {\"dict_load\": " << (dictMedian > 0 ? (dictBytes / 1e6) / (dictMedian / 1e3) : 0)
+         << ", \"grid_load\": " << (gridMedian > 0 ? (gridBytes / 1e6) / (gridMedian / 1e3) : 0) << "}}" << endl;
+    return 0;
+}
+
+// Names of the 8 directions for the layout report
+static const char* directionNames[] = {"up_left", "up", "up_right", "right", "down_right", "down", "down_left", "left"};
+
+// Walk the trie from every cell in direction d over nested rows, as the scan engine does; returns the trie steps taken
+static uint64_t walkNested(const vector<vector<char>>& grid, int rows, int cols, const FlatTrie& trie, int d)
+{
+    uint64_t steps = 0;
+    int dirX = gridDx[d];
+    int dirY = gridDy[d];
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < cols; j++)
+        {
+            uint32_t node = trie.root();
+            for (int x = i, y = j; x >= 0 && x < rows && y >= 0 && y < cols; x += dirX, y += dirY)
+            {
+                unsigned char index = letterCodes[static_cast<unsigned char>(grid[x][y])];
+                if (index >= 26 || (node = trie.child(node, index)) == 0)
+                {
+                    break;
+                }
+                steps++;
+            }
+        }
+    }
+    return steps;
+}
+
+// The same walks over the PackedGrid line that direction d runs along
+static uint64_t walkPacked(const PackedGrid& packed, const FlatTrie& trie, int d)
+{
+    uint64_t steps = 0;
+    PackedGrid::Family family = PackedGrid::directionFamily(d);
+    int step = PackedGrid::directionStep(d);
+    for (int i = 0; i < packed.rows(); i++)
+    {
+        for (int j = 0; j < packed.cols(); j++)
+        {
+            int line;
+            int position;
+            packed.locate(family, i, j, line, position);
+            const unsigned char* cell = packed.line(family, line) + position;
+            int available = step > 0 ? packed.lineLength(family, line) - position : position + 1;
+
+            uint32_t node = trie.root();
+            for (int k = 0; k < available; k++, cell += step)
+            {
+                if (*cell >= 26 || (node = trie.child(node, *cell)) == 0)
+                {
+                    break;
+                }
+                steps++;
+            }
+        }
+    }
+    return steps;
+}
+
+// Stream every line in direction d through a small state table over nested rows, the Aho-Corasick access pattern
+static uint32_t streamNested(const vector<vector<char>>& grid, int rows, int cols, const vector<uint32_t>& table, int d)
+{
+    uint32_t checksum = 0;
+    int dirX = gridDx[d];
+    int dirY = gridDy[d];
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < cols; j++)
+        {
+            // Start only on the edge cells a line in this direction enters from
+            if ((i - dirX >= 0 && i - dirX < rows) && (j - dirY >= 0 && j - dirY < cols))
+            {
+                continue;
+            }
+            uint32_t state = 0;
+            for (int x = i, y = j; x >= 0 && x < rows && y >= 0 && y < cols; x += dirX, y += dirY)
+            {
+                state = table[(state << 5) | letterCodes[static_cast<unsigned char>(grid[x][y])]];
+            }
+            checksum += state;
+        }
+    }
+    return checksum;
+}
+
+// The same streams over the PackedGrid, each line read in one contiguous pass
+static uint32_t streamPacked(const PackedGrid& packed, const vector<uint32_t>& table, int d)
+{
+    uint32_t checksum = 0;
+    PackedGrid::Family family = PackedGrid::directionFamily(d);
+    int step = PackedGrid::directionStep(d);
+    for (int line = 0; line < packed.lineCount(family); line++)
+    {
+        int length = packed.lineLength(family, line);
+        const unsigned char* cell = packed.line(family, line) + (step > 0 ? 0 : length - 1);
+        uint32_t state = 0;
+        for (int k = 0; k < length; k++, cell += step)
+        {
+            state = table[(state << 5) | *cell];
+        }
+        checksum += state;
+    }
+    return checksum;
+}
+
+// Median-time speedup of the packed layout over nested rows for one kernel
+static string compareLayouts(const vector<double>& nested, const vector<double>& packed)
+{
+    ostringstream out;
+    double nestedMedian = quantile(nested, 0.5);
+    double packedMedian = quantile(packed, 0.5);
+    out << "{\"nested_ms\": " << nestedMedian << ", \"packed_ms\": " << packedMedian
+        << ", \"speedup\": " << (packedMedian > 0 ? nestedMedian / packedMedian : 0) << "}";
+    return out.str();
+}
+
+// Time each direction's trie walks and line streams over both grid layouts
+static int runLayoutSuite(const BenchOptions& options)
+{
+    vector<string> words = generateWords(options.words, options.prefixShare, options.minLength, options.maxLength, options.seed, options.suffixShare);
+    size_t plant = options.plant > 0 ? options.plant : static_cast<size_t>(options.rows) * options.cols / 64;
+    vector<vector<char>> grid = generateGrid(options.rows, options.cols, words, plant, options.seed + 1);
+
+    FlatTrie trie;
+    for (const auto& word : words)
+    {
+        trie.insert(word);
+    }
+
+    // 256 states by 32 codes, so each step depends on the last like an automaton transition
+    WorkloadRng rng(options.seed + 2);
+    vector<uint32_t> table(256 * 32);
+    for (auto& next : table)
+    {
+        next = rng.below(256);
+    }
+
+    PackedGrid packed;
+    vector<double> buildSamples;
+    vector<double> walkSamples[8][2];
+    vector<double> streamSamples[8][2];
+    uint64_t mismatches = 0;
+
+    for (int run = 0; run < options.warmup + options.runs; run++)
+    {
+        bool timed = run >= options.warmup;
+        auto start = chrono::steady_clock::now();
+        packed.build(grid);
+        double buildMs = elapsedMs(start);
+        if (timed) buildSamples.push_back(buildMs);
+
+        for (int d = 0; d < 8; d++)
+        {
+            start = chrono::steady_clock::now();
+            uint64_t nestedSteps = walkNested(grid, options.rows, options.cols, trie, d);
+            double nestedWalkMs = elapsedMs(start);
+
+            start = chrono::steady_clock::now();
+            uint64_t packedSteps = walkPacked(packed, trie, d);
+            double packedWalkMs = elapsedMs(start);
+
+            start = chrono::steady_clock::now();
+            uint32_t nestedSum = streamNested(grid, options.rows, options.cols, table, d);
+            double nestedStreamMs = elapsedMs(start);
+
+            start = chrono::steady_clock::now();
+            uint32_t packedSum = streamPacked(packed, table, d);
+            double packedStreamMs = elapsedMs(start);
+
+            // Both layouts must do exactly the same work, or the timings mean nothing
+            mismatches += (nestedSteps != packedSteps) + (nestedSum != packedSum);
+            if (timed)
+            {
+                walkSamples[d][0].push_back(nestedWalkMs);
+                walkSamples[d][1].push_back(packedWalkMs);
+                streamSamples[d][0].push_back(nestedStreamMs);
+                streamSamples[d][1].push_back(packedStreamMs);
+            }
+        }
+    }
+
+    cout << "{\"suite\": \"layout\", \"rows\": " << options.rows << ", \"cols\": " << options.cols
+         << ", \"words\": " << words.size() << ", \"seed\": " << options.seed << ", \"runs\": " << options.runs
+         << ", \"packed_build\": " << summarise(buildSamples) << ", \"packed_bytes\": " << packed.bytes()
+         << ", \"mismatches\": " << mismatches << ", \"directions\": {";
+    for (int d = 0; d < 8; d++)
+    {
+        cout << (d > 0 ? ", " : "") << "\"" << directionNames[d] << "\": {\"walk\": " << compareLayouts(walkSamples[d][0], walkSamples[d][1])
+             << ", \"stream\": " << compareLayouts(streamSamples[d][0], streamSamples[d][1]) << "}";
+    }
+    cout << "}}" << endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+// JSON summary of one dictionary in the dict suite
+static string describeDictionary(const vector<double>& build, const vector<double>& search, size_t nodes, size_t bytes, size_t words)
+{
+    ostringstream out;
+    out << "{\"build\": " << summarise(build) << ", \"search\": " << summarise(search) << ", \"nodes\": " << nodes
+        << ", \"bytes\": " << bytes << ", \"bytes_per_word\": " << (words > 0 ? static_cast<double>(bytes) / words : 0) << "}";
+    return out.str();
+}
+
+// Build the pointer Trie, the FlatTrie and the Dawg from the same words, then check and time lookups in each
+static int runDictSuite(const BenchOptions& options)
+{
+    vector<string> words = generateWords(options.words, options.prefixShare, options.minLength, options.maxLength, options.seed, options.suffixShare);
+    size_t plant = options.plant > 0 ? options.plant : static_cast<size_t>(options.rows) * options.cols / 64;
+    vector<vector<char>> grid = generateGrid(options.rows, options.cols, words, plant, options.seed + 1);
+
+    vector<double> buildSamples[3];
+    vector<double> searchSamples[3];
+    size_t nodes[3] = {0, 0, 0};
+    size_t bytes[3] = {0, 0, 0};
+    size_t dawgEdges = 0;
+    uint64_t mismatches = 0;
+    set<string> ignoreWords;
+
+    for (int run = 0; run < options.warmup + options.runs; run++)
+    {
+        bool timed = run >= options.warmup;
+        vector<pair<string, pair<pair<int, int>, pair<int, int>>>> locations[3];
+        GridSearch gridSearch;
+
+        // Each dictionary is released before the next is built, so the three never share memory
+        {
+            auto start = chrono::steady_clock::now();
+            Trie trie;
+            for (const auto& word : words)
+            {
+                trie.insert(word);
+            }
+            double buildMs = elapsedMs(start);
+            start = chrono::steady_clock::now();
+            gridSearch.searchWords(grid, &trie, locations[0], ignoreWords, options.minWordLength);
+            double searchMs = elapsedMs(start);
+            if (timed)
+            {
+                buildSamples[0].push_back(buildMs);
+                searchSamples[0].push_back(searchMs);
+            }
+            nodes[0] = trie.nodeCount();
+            bytes[0] = trie.bytes();
+        }
+
+        FlatTrie flat;
+        auto start = chrono::steady_clock::now();
+        for (const auto& word : words)
+        {
+            flat.insert(word);
+        }
+        double flatBuildMs = elapsedMs(start);
+        start = chrono::steady_clock::now();
+        gridSearch.searchWords(grid, &flat, locations[1], ignoreWords, options.minWordLength);
+        double flatSearchMs = elapsedMs(start);
+
+        Dawg dawg;
+        start = chrono::steady_clock::now();
+        dawg.build(words);
+        double dawgBuildMs = elapsedMs(start);
+        start = chrono::steady_clock::now();
+        gridSearch.searchWords(grid, &dawg, locations[2], ignoreWords, options.minWordLength);
+        double dawgSearchMs = elapsedMs(start);
+
+        if (timed)
+        {
+            buildSamples[1].push_back(flatBuildMs);
+            searchSamples[1].push_back(flatSearchMs);
+            buildSamples[2].push_back(dawgBuildMs);
+            searchSamples[2].push_back(dawgSearchMs);
+        }
+        nodes[1] = flat.nodeCount();
+        bytes[1] = flat.bytes();
+        nodes[2] = dawg.nodeCount();
+        bytes[2] = dawg.bytes();
+        dawgEdges = dawg.edgeCount();
+
+        // All three must find the same words in the same places, and the Dawg must hold exactly the FlatTrie's words
+        mismatches += (locations[0] != locations[1]) + (locations[1] != locations[2]);
+        if (run == 0)
+        {
+            for (const auto& word : words)
+            {
+                mismatches += !dawg.search(word);
+            }
+            WorkloadRng rng(options.seed + 4);
+            for (int probe = 0; probe < 100000; probe++)
+            {
+                string text;
+                int length = 1 + static_cast<int>(rng.below(static_cast<uint32_t>(options.maxLength)));
+                for (int k = 0; k < length; k++)
+                {
+                    text += rng.letter();
+                }
+                mismatches += (dawg.search(text) != flat.search(text)) + (dawg.startsWith(text) != flat.startsWith(text));
+            }
+        }
+    }
+
+    cout << "{\"suite\": \"dict\", \"rows\": " << options.rows << ", \"cols\": " << options.cols
+         << ", \"words\": " << words.size() << ", \"prefix_share\": " << options.prefixShare << ", \"suffix_share\": " << options.suffixShare
+         << ", \"seed\": " << options.seed << ", \"runs\": " << options.runs
+         << ", \"dictionaries\": {\"trie\": " << describeDictionary(buildSamples[0], searchSamples[0], nodes[0], bytes[0], words.size())
+         << ", \"flat\": " << describeDictionary(buildSamples[1], searchSamples[1], nodes[1], bytes[1], words.size())
+         << ", \"dawg\": " << describeDictionary(buildSamples[2], searchSamples[2], nodes[2], bytes[2], words.size())
+         << "}, \"dawg_edges\": " << dawgEdges << ", \"mismatches\": " << mismatches << "}" << endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Time the boggle search on boards of each size, pruned against unpruned and threaded against single-threaded
+static int runBoggleSuite(const BenchOptions& options)
+{
+    vector<string> words = generateWords(options.words, options.prefixShare, options.minLength, options.maxLength, options.seed, options.suffixShare);
+    FlatTrie trie;
+    for (const auto& word : words)
+    {
+        trie.insert(word);
+    }
+
+    vector<int> sizes;
+    stringstream list(options.sizes);
+    string item;
+    while (getline(list, item, ','))
+    {
+        int size = stoi(item);
+        if (size <= 0)
+        {
+            cerr << "Error: Board sizes must be positive." << endl;
+            return 1;
+        }
+        sizes.push_back(size);
+    }
+
+    BoggleSearch boggle;
+    uint64_t mismatches = 0;
+    cout << "{\"suite\": \"boggle\", \"words\": " << words.size() << ", \"prefix_share\": " << options.prefixShare
+         << ", \"seed\": " << options.seed << ", \"runs\": " << options.runs << ", \"threads\": " << options.threads
+         << ", \"max_path\": " << options.maxPath << ", \"boards\": [";
+
+    for (size_t b = 0; b < sizes.size(); b++)
+    {
+        int size = sizes[b];
+        size_t plant = options.plant > 0 ? options.plant : max(static_cast<size_t>(1), static_cast<size_t>(size) * size / 64);
+        vector<vector<char>> grid = generateGrid(size, size, words, plant, options.seed + 1 + b);
+
+        // Time both modes, each run a fresh search of the same board
+        vector<double> samples[2];
+        vector<pair<string, pair<pair<int, int>, pair<int, int>>>> locations[2];
+        for (int pruned = 1; pruned >= 0; pruned--)
+        {
+            boggle.setPruning(pruned != 0);
+            for (int run = 0; run < options.warmup + options.runs; run++)
+            {
+                locations[pruned].clear();
+                auto start = chrono::steady_clock::now();
+                boggle.searchWords(grid, trie, locations[pruned], options.minWordLength, options.maxPath, options.threads);
+                double ms = elapsedMs(start);
+                if (run >= options.warmup) samples[pruned].push_back(ms);
+            }
+        }
+
+        // One counted run of each mode, and a single-threaded run that must give the same output
+        SearchStats counted[2];
+        for (int pruned = 1; pruned >= 0; pruned--)
+        {
+            boggle.setPruning(pruned != 0);
+            boggle.setStats(&counted[pruned]);
+            vector<pair<string, pair<pair<int, int>, pair<int, int>>>> check;
+            boggle.searchWords(grid, trie, check, options.minWordLength, options.maxPath, 1);
+            boggle.setStats(nullptr);
+            mismatches += check != locations[1];
+        }
+        mismatches += locations[0] != locations[1];
+        boggle.setPruning(true);
+
+        cout << (b == 0 ? "" : ", ") << "{\"size\": " << size << ", \"found\": " << locations[1].size()
+             << ", \"pruned\": " << summarise(samples[1]) << ", \"unpruned\": " << summarise(samples[0])
+             << ", \"trie_steps\": {\"pruned\": " << counted[1].trieSteps << ", \"unpruned\": " << counted[0].trieSteps << "}"
+             << ", \"exhausted_prunes\": " << counted[1].exhaustedPrunes << "}";
+    }
+
+    cout << "], \"mismatches\": " << mismatches << "}" << endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Time the exact scan, then the FuzzyScanner at every mismatch budget up to -k on the same grid
+static int runFuzzySuite(const BenchOptions& options)
+{
+    vector<string> words = generateWords(options.words, options.prefixShare, options.minLength, options.maxLength, options.seed, options.suffixShare);
+    size_t plant = options.plant > 0 ? options.plant : static_cast<size_t>(options.rows) * options.cols / 64;
+    vector<vector<char>> grid = generateGrid(options.rows, options.cols, words, plant, options.seed + 1);
+    FlatTrie trie;
+    for (const auto& word : words)
+    {
+        trie.insert(word);
+    }
+
+    // The exact scan is the baseline every budget is measured against
+    LineScanner lineScanner;
+    vector<double> exactSamples;
+    vector<pair<string, pair<pair<int, int>, pair<int, int>>>> exact;
+    for (int run = 0; run < options.warmup + options.runs; run++)
+    {
+        exact.clear();
+        auto start = chrono::steady_clock::now();
+        lineScanner.searchWords(grid, trie, exact, options.minWordLength);
+        double ms = elapsedMs(start);
+        if (run >= options.warmup) exactSamples.push_back(ms);
+    }
+    double exactMedian = quantile(exactSamples, 0.5);
+
+    auto start = chrono::steady_clock::now();
+    FuzzyScanner fuzzy(trie);
+    double indexMs = elapsedMs(start);
+
+    uint64_t mismatches = 0;
+    cout << "{\"suite\": \"fuzzy\", \"rows\": " << options.rows << ", \"cols\": " << options.cols << ", \"words\": " << words.size()
+         << ", \"prefix_share\": " << options.prefixShare << ", \"seed\": " << options.seed << ", \"runs\": " << options.runs
+         << ", \"min_word_length\": " << options.minWordLength << ", \"index_ms\": " << indexMs << ", \"index_bytes\": " << fuzzy.bytes()
+         << ", \"exact\": {\"found\": " << exact.size() << ", \"search\": " << summarise(exactSamples) << "}, \"budgets\": [";
+
+    for (int k = 0; k <= options.maxMismatches; k++)
+    {
+        vector<double> samples;
+        vector<pair<string, pair<pair<int, int>, pair<int, int>>>> locations;
+        vector<int> counts;
+        for (int run = 0; run < options.warmup + options.runs; run++)
+        {
+            locations.clear();
+            counts.clear();
+            start = chrono::steady_clock::now();
+            fuzzy.searchWords(grid, locations, counts, options.minWordLength, k);
+            double ms = elapsedMs(start);
+            if (run >= options.warmup) samples.push_back(ms);
+        }
+
+        // One counted run, for the steps and hits the budget costs
+        SearchStats counted;
+        fuzzy.setStats(&counted);
+        vector<pair<string, pair<pair<int, int>, pair<int, int>>>> check;
+        vector<int> checkCounts;
+        fuzzy.searchWords(grid, check, checkCounts, options.minWordLength, k);
+        fuzzy.setStats(nullptr);
+        mismatches += check != locations;
+        if (k == 0) mismatches += locations != exact;
+
+        size_t inexact = static_cast<size_t>(count_if(counts.begin(), counts.end(), [](int c) { return c > 0; }));
+        double median = quantile(samples, 0.5);
+        cout << (k == 0 ? "" : ", ") << "{\"k\": " << k << ", \"found\": " << locations.size() << ", \"inexact\": " << inexact
+             << ", \"search\": " << summarise(samples) << ", \"vs_exact\": " << (exactMedian > 0 ? median / exactMedian : 0)
+             << ", \"trie_steps\": " << counted.trieSteps << ", \"hits\": " << counted.hits << "}";
+    }
+
+    cout << "], \"mismatches\": " << mismatches << "}" << endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Write results the way GridLex did before the ResultWriter, one stream insertion chain and endl flush per line
+static void writeLineByLine(ostream& out, const vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, const SearchResults& all)
+{
+    out << "Found words and their locations: " << endl;
+    for (const auto& entry : locations)
+    {
+        out << "Word: " << entry.first << " from position (" << entry.second.first.first << ", " << entry.second.first.second
+            << ") to position (" << entry.second.second.first << ", " << entry.second.second.second << ")" << endl;
+    }
+    for (const auto& hit : all.hits)
+    {
+        int endX = hit.row + (hit.length - 1) * gridDx[hit.dir];
+        int endY = hit.col + (hit.length - 1) * gridDy[hit.dir];
+        out << "Word: " << all.words.word(hit.wordId) << " from position (" << hit.row + 1 << ", " << hit.col + 1
+            << ") to position (" << endX + 1 << ", " << endY + 1 << ")" << endl;
+    }
+}
+
+// Read a whole file back, for comparing outputs
+static string readWholeFile(const string& path)
+{
+    ifstream in(path, ios::binary);
+    ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+// Time writing one scan's results to a file in each output format, against the old line-by-line output
+static int runOutputSuite(const BenchOptions& options)
+{
+    vector<string> words = generateWords(options.words, options.prefixShare, options.minLength, options.maxLength, options.seed, options.suffixShare);
+    size_t plant = options.plant > 0 ? options.plant : static_cast<size_t>(options.rows) * options.cols / 64;
+    vector<vector<char>> grid = generateGrid(options.rows, options.cols, words, plant, options.seed + 1);
+    FlatTrie trie;
+    for (const auto& word : words)
+    {
+        trie.insert(word);
+    }
+
+    // One search provides the results every format writes
+    LineScanner scanner;
+    vector<pair<string, pair<pair<int, int>, pair<int, int>>>> locations;
+    SearchResults all;
+    if (options.all)
+    {
+        scanner.searchAll(grid, trie, all, options.minWordLength, options.threads);
+    }
+    else
+    {
+        scanner.searchWords(grid, trie, locations, options.minWordLength, options.threads);
+    }
+    size_t hits = options.all ? all.hits.size() : locations.size();
+
+    // The line-by-line baseline first, then each ResultWriter format
+    const char* formats[] = {"lines", "text", "json", "csv", "bin"};
+    uint64_t mismatches = 0;
+    cout << "{\"suite\": \"output\", \"rows\": " << options.rows << ", \"cols\": " << options.cols << ", \"words\": " << words.size()
+         << ", \"seed\": " << options.seed << ", \"runs\": " << options.runs << ", \"all\": " << (options.all ? "true" : "false")
+         << ", \"hits\": " << hits << ", \"formats\": [";
+    double linesMedian = 0;
+    for (size_t f = 0; f < 5; f++)
+    {
+        OutputFormat format = OutputFormat::Text;
+        bool lines = f == 0;
+        if (!lines)
+        {
+            parseOutputFormat(formats[f], format);
+        }
+        string path = options.workDir + "/bench_output." + formats[f];
+        vector<double> samples;
+        size_t bytes = 0;
+        for (int run = 0; run < options.warmup + options.runs; run++)
+        {
+            // Timed through the file's close, so the last buffered bytes are counted
+            auto start = chrono::steady_clock::now();
+            {
+                ofstream out(path, ios::trunc | ios::binary);
+                if (lines)
+                {
+                    writeLineByLine(out, locations, all);
+                }
+                else
+                {
+                    ResultWriter writer(out, format);
+                    if (options.all)
+                    {
+                        writer.write(all);
+                    }
+                    else
+                    {
+                        writer.write(locations, vector<int>());
+                    }
+                    bytes = writer.bytesWritten();
+                }
+            }
+            double ms = elapsedMs(start);
+            if (run >= options.warmup) samples.push_back(ms);
+        }
+
+        // The buffered text must be byte for byte the line-by-line output
+        if (lines)
+        {
+            bytes = readWholeFile(path).size();
+        }
+        else if (format == OutputFormat::Text)
+        {
+            mismatches += readWholeFile(path) != readWholeFile(options.workDir + "/bench_output.lines");
+        }
+
+        double median = quantile(samples, 0.5);
+        if (lines) linesMedian = median;
+        cout << (f == 0 ? "" : ", ") << "{\"format\": \"" << formats[f] << "\", \"bytes\": " << bytes << ", \"write\": " << summarise(samples)
+             << ", \"ms_per_million_hits\": " << (hits > 0 ? median * 1e6 / hits : 0)
+             << ", \"mb_s\": " << (median > 0 ? (bytes / 1e6) / (median / 1e3) : 0)
+             << ", \"vs_lines\": " << (linesMedian > 0 ? median / linesMedian : 0) << "}";
+    }
+
+    cout << "], \"mismatches\": " << mismatches << "}" << endl;
+    return mismatches == 0 ? 0 : 1;
+}
+
+// Time SearchSession cell edits, then check the session against a full search of the edited grid
+static int runEditSuite(const BenchOptions& options)
+{
+    vector<string> words = generateWords(options.words, options.prefixShare, options.minLength, options.maxLength, options.seed, options.suffixShare);
+    size_t plant = options.plant > 0 ? options.plant : static_cast<size_t>(options.rows) * options.cols / 64;
+    vector<vector<char>> grid = generateGrid(options.rows, options.cols, words, plant, options.seed + 1);
+
+    FlatTrie trie;
+    for (const auto& word : words)
+    {
+        trie.insert(word);
+    }
+
+    SearchSession session(trie, options.minWordLength);
+    auto start = chrono::steady_clock::now();
+    session.load(grid);
+    double loadMs = elapsedMs(start);
+
+    // Replay the added and removed reports on the starting words, they must end where the session does
+    vector<string> initial = session.words();
+    set<string> replayed(initial.begin(), initial.end());
+    WorkloadRng rng(options.seed + 3);
+    vector<double> editSamples;
+    vector<string> added;
+    vector<string> removed;
+    size_t addedCount = 0;
+    size_t removedCount = 0;
+    for (int e = 0; e < options.edits; e++)
+    {
+        int row = static_cast<int>(rng.below(options.rows));
+        int col = static_cast<int>(rng.below(options.cols));
+        char letter = rng.letter();
+        grid[row][col] = letter;
+
+        start = chrono::steady_clock::now();
+        session.setCell(row, col, letter, added, removed);
+        editSamples.push_back(elapsedMs(start));
+
+        addedCount += added.size();
+        removedCount += removed.size();
+        for (const auto& word : removed)
+        {
+            replayed.erase(word);
+        }
+        replayed.insert(added.begin(), added.end());
+    }
+
+    // The full all-occurrences search of the edited grid is both the timing baseline and the reference
+    vector<double> fullSamples;
+    SearchResults all;
+    LineScanner scanner;
+    for (int run = 0; run < options.warmup + options.runs; run++)
+    {
+        start = chrono::steady_clock::now();
+        scanner.searchAll(grid, trie, all, options.minWordLength);
+        double fullMs = elapsedMs(start);
+        if (run >= options.warmup) fullSamples.push_back(fullMs);
+    }
+    vector<string> reference;
+    for (uint32_t id = 0; id < all.words.size(); id++)
+    {
+        string word = all.words.word(id);
+        transform(word.begin(), word.end(), word.begin(), ::toupper);
+        reference.push_back(word);
+    }
+    sort(reference.begin(), reference.end());
+
+    vector<string> current = session.words();
+    bool consistent = current == reference && all.hits.size() == session.occurrenceCount()
+                      && vector<string>(replayed.begin(), replayed.end()) == current;
+
+    double editMedian = editSamples.empty() ? 0 : quantile(editSamples, 0.5);
+    double fullMedian = quantile(fullSamples, 0.5);
+    cout << "{\"suite\": \"edit\", \"rows\": " << options.rows << ", \"cols\": " << options.cols
+         << ", \"words\": " << words.size() << ", \"seed\": " << options.seed << ", \"edits\": " << options.edits
+         << ", \"load_ms\": " << loadMs;
+    if (!editSamples.empty())
+    {
+        cout << ", \"edit\": " << summarise(editSamples);
+    }
+    cout << ", \"full_search\": " << summarise(fullSamples)
+         << ", \"speedup\": " << (editMedian > 0 ? fullMedian / editMedian : 0)
+         << ", \"words_added\": " << addedCount << ", \"words_removed\": " << removedCount
+         << ", \"words_present\": " << session.wordCount() << ", \"occurrences\": " << session.occurrenceCount()
+         << ", \"consistent\": " << (consistent ? "true" : "false") << "}" << endl;
+    return consistent ? 0 : 1;
+}
+
+// Only write the workload, so it can be fed to GridLex by hand
+static int runGenerateSuite(const BenchOptions& options)
+{
+    string gridFile;
+    string wordsFile;
+    size_t wordCount = 0;
+    if (!writeWorkload(options, gridFile, wordsFile, wordCount))
+    {
+        return 1;
+    }
+
+    cout << "{\"suite\": \"generate\", \"grid_file\": \"" << gridFile << "\", \"words_file\": \"" << wordsFile
+         << "\", \"rows\": " << options.rows << ", \"cols\": " << options.cols << ", \"words\": " << wordCount
+         << ", \"seed\": " << options.seed << "}" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-h") == 0)
+        {
+            displayHelp();
+            return 0;
+        }
+    }
+
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    if (options.suite == "search")
+    {
+        return runSearchSuite(options);
+    }
+    if (options.suite == "generate")
+    {
+        return runGenerateSuite(options);
+    }
+    if (options.suite == "layout")
+    {
+        return runLayoutSuite(options);
+    }
+    if (options.suite == "dict")
+    {
+        return runDictSuite(options);
+    }
+    if (options.suite == "boggle")
+    {
+        return runBoggleSuite(options);
+    }
+    if (options.suite == "fuzzy")
+    {
+        return runFuzzySuite(options);
+    }
+    if (options.suite == "output")
+    {
+        return runOutputSuite(options);
+    }
+    if (options.suite == "edit")
+    {
+        return runEditSuite(options);
+    }
+
+    cerr << "Error: Unknown benchmark suite " << options.suite << ". Use -h for help." << endl;
+    return 1;
+}
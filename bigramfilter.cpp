@@ -0,0 +1,354 @@
+/***************************************************************
+# bigramfilter.cpp
+# Code implementing the SIMD bigram prefilter for straight-line walks
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of BigramFilter class
+# 2026.10.2    15.10.2026   Dawg overload of build, sharing the FlatTrie code
+# 2026.10.3    16.10.2026   Direction and letter code tables come from directions.h
+****************************************************************/
+
+#include "bigramfilter.h"
+#include "directions.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BIGRAM_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define BIGRAM_TARGET(isa)  // MSVC accepts every intrinsic without per-function targets
+#else
+#define BIGRAM_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+using namespace std;
+
+// Letter code of a cell that is not a letter, and of the cells past the grid edge
+static const unsigned char noLetter = 26;
+
+// Cells of padding either side of each row of codes, so the SIMD kernels can read past both ends
+static const int codePadding = 64;
+
+// Mark the candidates of one row and direction: bit j is set when follow[a[j]] has bit b[j]
+typedef void (*MaskKernel)(const unsigned char* a, const unsigned char* b, int n, const uint32_t* follow, const uint8_t (*followBytes)[32], uint64_t* out);
+
+static void maskScalar(const unsigned char* a, const unsigned char* b, int n, const uint32_t* follow, const uint8_t (*)[32], uint64_t* out)
+{
+    for (int j = 0; j < n; j++)
+    {
+        out[j >> 6] |= static_cast<uint64_t>((follow[a[j]] >> b[j]) & 1) << (j & 63);
+    }
+}
+
+static void maskOff(const unsigned char*, const unsigned char*, int n, const uint32_t*, const uint8_t (*)[32], uint64_t* out)
+{
+    for (int j = 0; j < n; j++)
+    {
+        out[j >> 6] |= uint64_t(1) << (j & 63);
+    }
+}
+
+#ifdef BIGRAM_X86
+
+// The shuffle kernels look up byte k of follow[a] with two 16-entry byte shuffles (codes 0-15
+// and 16-31), pick the byte holding bit b (b / 8) and test bit b % 8 of it.
+// Bits are written 16 or 32 at a time, so out needs room rounded up to 32 cells.
+
+BIGRAM_TARGET("ssse3")
+static void maskSsse3(const unsigned char* a, const unsigned char* b, int n, const uint32_t*, const uint8_t (*followBytes)[32], uint64_t* out)
+{
+    __m128i low[4];
+    __m128i high[4];
+    for (int k = 0; k < 4; k++)
+    {
+        low[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(followBytes[k]));
+        high[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(followBytes[k] + 16));
+    }
+    const __m128i bitOf = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i lowBias = _mm_set1_epi8(0x70);  // Codes 16 and up saturate to 0x80 and more, which shuffle to 0
+    const __m128i sixteen = _mm_set1_epi8(16);
+    const __m128i seven = _mm_set1_epi8(7);
+    const __m128i three = _mm_set1_epi8(3);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (int j = 0; j < n; j += 16)
+    {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + j));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i lowIndex = _mm_adds_epu8(first, lowBias);
+        __m128i highIndex = _mm_sub_epi8(first, sixteen);  // Codes below 16 wrap to 0xF0 and up, which shuffle to 0
+        __m128i byteIndex = _mm_and_si128(_mm_srli_epi16(second, 3), three);
+        __m128i bit = _mm_shuffle_epi8(bitOf, _mm_and_si128(second, seven));
+
+        __m128i picked = zero;
+        for (int k = 0; k < 4; k++)
+        {
+            __m128i byteK = _mm_or_si128(_mm_shuffle_epi8(low[k], lowIndex), _mm_shuffle_epi8(high[k], highIndex));
+            picked = _mm_or_si128(picked, _mm_and_si128(byteK, _mm_cmpeq_epi8(byteIndex, _mm_set1_epi8(static_cast<char>(k)))));
+        }
+        uint16_t mask = static_cast<uint16_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(picked, bit), zero)));
+        memcpy(reinterpret_cast<char*>(out) + j / 8, &mask, sizeof(mask));
+    }
+}
+
+BIGRAM_TARGET("avx2")
+static void maskAvx2(const unsigned char* a, const unsigned char* b, int n, const uint32_t*, const uint8_t (*followBytes)[32], uint64_t* out)
+{
+    // Shuffles stay within 128-bit lanes, so each table is repeated in both lanes
+    __m256i low[4];
+    __m256i high[4];
+    for (int k = 0; k < 4; k++)
+    {
+        low[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(followBytes[k])));
+        high[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(followBytes[k] + 16)));
+    }
+    const __m256i bitOf = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                           1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i lowBias = _mm256_set1_epi8(0x70);
+    const __m256i sixteen = _mm256_set1_epi8(16);
+    const __m256i seven = _mm256_set1_epi8(7);
+    const __m256i three = _mm256_set1_epi8(3);
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (int j = 0; j < n; j += 32)
+    {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + j));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i lowIndex = _mm256_adds_epu8(first, lowBias);
+        __m256i highIndex = _mm256_sub_epi8(first, sixteen);
+        __m256i byteIndex = _mm256_and_si256(_mm256_srli_epi16(second, 3), three);
+        __m256i bit = _mm256_shuffle_epi8(bitOf, _mm256_and_si256(second, seven));
+
+        __m256i picked = zero;
+        for (int k = 0; k < 4; k++)
+        {
+            __m256i byteK = _mm256_or_si256(_mm256_shuffle_epi8(low[k], lowIndex), _mm256_shuffle_epi8(high[k], highIndex));
+            picked = _mm256_or_si256(picked, _mm256_and_si256(byteK, _mm256_cmpeq_epi8(byteIndex, _mm256_set1_epi8(static_cast<char>(k)))));
+        }
+        uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(picked, bit), zero)));
+        memcpy(reinterpret_cast<char*>(out) + j / 8, &mask, sizeof(mask));
+    }
+}
+
+// CPU feature checks, including OS support for the AVX registers
+static bool cpuHasSsse3()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+static bool cpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool osSaves = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return osSaves && (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // BIGRAM_X86
+
+// Whether this CPU can run a kernel
+static bool kernelSupported(BigramFilter::Kernel kernel)
+{
+#ifdef BIGRAM_X86
+    if (kernel == BigramFilter::Avx2) return cpuHasAvx2();
+    if (kernel == BigramFilter::Ssse3) return cpuHasSsse3();
+#else
+    if (kernel == BigramFilter::Avx2 || kernel == BigramFilter::Ssse3) return false;
+#endif
+    return true;
+}
+
+// Widest kernel this CPU supports
+static BigramFilter::Kernel bestKernel()
+{
+    if (kernelSupported(BigramFilter::Avx2)) return BigramFilter::Avx2;
+    if (kernelSupported(BigramFilter::Ssse3)) return BigramFilter::Ssse3;
+    return BigramFilter::Scalar;
+}
+
+static atomic<int> currentKernel(static_cast<int>(bestKernel()));
+
+// Constructor, nothing passes until build is called
+BigramFilter::BigramFilter()
+{
+    memset(follow, 0, sizeof(follow));
+    prepareTables();
+}
+
+// Letter pairs that start a path in a pointer-based Trie
+void BigramFilter::build(const Trie& trie, int minWordLength)
+{
+    memset(follow, 0, sizeof(follow));
+    for (int first = 0; first < 26; first++)
+    {
+        const TrieNode* node = trie.root->children[first];
+        if (node == nullptr)
+        {
+            continue;
+        }
+        for (int second = 0; second < 26; second++)
+        {
+            if (node->children[second] != nullptr)
+            {
+                follow[first] |= uint32_t(1) << second;
+            }
+        }
+        if (node->isEndOfWord && minWordLength <= 1)
+        {
+            follow[first] = (uint32_t(1) << 27) - 1;  // A one-letter word is found whatever comes next
+        }
+    }
+    prepareTables();
+}
+
+// Letter pairs that start a path in any trie walked by node index
+template <typename IndexTrie>
+void BigramFilter::buildIndexed(const IndexTrie& trie, int minWordLength)
+{
+    memset(follow, 0, sizeof(follow));
+    for (int first = 0; first < 26; first++)
+    {
+        uint32_t node = trie.child(trie.root(), first);
+        if (node == 0)
+        {
+            continue;
+        }
+        for (int second = 0; second < 26; second++)
+        {
+            if (trie.child(node, second) != 0)
+            {
+                follow[first] |= uint32_t(1) << second;
+            }
+        }
+        if (trie.isEndOfWord(node) && minWordLength <= 1)
+        {
+            follow[first] = (uint32_t(1) << 27) - 1;  // A one-letter word is found whatever comes next
+        }
+    }
+    prepareTables();
+}
+
+// Letter pairs that start a path in a FlatTrie
+void BigramFilter::build(const FlatTrie& trie, int minWordLength)
+{
+    buildIndexed(trie, minWordLength);
+}
+
+// Letter pairs that start a path in a Dawg
+void BigramFilter::build(const Dawg& trie, int minWordLength)
+{
+    buildIndexed(trie, minWordLength);
+}
+
+// Byte k of every follow mask, laid out as the shuffle kernels load it
+void BigramFilter::prepareTables()
+{
+    for (int k = 0; k < 4; k++)
+    {
+        for (int code = 0; code < 32; code++)
+        {
+            followBytes[k][code] = static_cast<uint8_t>(follow[code] >> (8 * k));
+        }
+    }
+}
+
+// Candidate masks of one grid row for all 8 directions
+void BigramFilter::rowMasks(const vector<vector<char>>& grid, int row, int cols, vector<unsigned char>& codes, uint64_t* const masks[8]) const
+{
+    // Letter codes of the rows above, at and below this one, padded with noLetter
+    size_t stride = static_cast<size_t>(cols) + 2 * codePadding;
+    codes.assign(3 * stride, noLetter);
+    int rows = static_cast<int>(grid.size());
+    for (int r = 0; r < 3; r++)
+    {
+        int source = row - 1 + r;
+        if (source < 0 || source >= rows)
+        {
+            continue;
+        }
+        const char* cells = grid[source].data();
+        int width = min(cols, static_cast<int>(grid[source].size()));  // A short row ends in non-letters
+        unsigned char* target = codes.data() + r * stride + codePadding;
+        for (int j = 0; j < width; j++)
+        {
+            // c | 0x20 folds A-Z onto a-z and leaves nothing else in that range
+            unsigned char code = static_cast<unsigned char>((static_cast<unsigned char>(cells[j]) | 0x20) - 'a');
+            target[j] = code < 26 ? code : noLetter;
+        }
+    }
+
+    MaskKernel kernel;
+    switch (activeKernel())
+    {
+#ifdef BIGRAM_X86
+    case Avx2: kernel = maskAvx2; break;
+    case Ssse3: kernel = maskSsse3; break;
+#endif
+    case Off: kernel = maskOff; break;
+    default: kernel = maskScalar; break;
+    }
+
+    const unsigned char* first = codes.data() + stride + codePadding;
+    size_t words = wordsPerRow(cols);
+    for (int d = 0; d < 8; d++)
+    {
+        const unsigned char* second = codes.data() + (1 + gridDx[d]) * stride + codePadding + gridDy[d];
+        memset(masks[d], 0, words * sizeof(uint64_t));
+        kernel(first, second, cols, follow, followBytes, masks[d]);
+        if (cols & 63)
+        {
+            masks[d][words - 1] &= (uint64_t(1) << (cols & 63)) - 1;  // Kernels may mark padding past the last cell
+        }
+    }
+}
+
+// Switch every filter to a kernel, if this CPU can run it
+bool BigramFilter::setKernel(Kernel kernel)
+{
+    if (kernel == Auto)
+    {
+        kernel = bestKernel();
+    }
+    if (!kernelSupported(kernel))
+    {
+        return false;
+    }
+    currentKernel = static_cast<int>(kernel);
+    return true;
+}
+
+BigramFilter::Kernel BigramFilter::activeKernel()
+{
+    return static_cast<Kernel>(currentKernel.load(memory_order_relaxed));
+}
+
+const char* BigramFilter::kernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Avx2: return "avx2";
+    case Ssse3: return "ssse3";
+    case Scalar: return "scalar";
+    case Off: return "off";
+    default: return "auto";
+    }
+}
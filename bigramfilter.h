@@ -0,0 +1,70 @@
+/***************************************************************
+# bigramfilter.h
+# Header for bigramfilter.cpp, defines the BigramFilter start cell prefilter
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of BigramFilter class
+# 2026.10.2    15.10.2026   Added a Dawg overload of build
+****************************************************************/
+
+#ifndef BIGRAMFILTER_H
+#define BIGRAMFILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "trie.h"
+#include "flattrie.h"
+#include "dawg.h"
+
+// BigramFilter class definition.
+// Most straight-line walks die within two letters. The filter keeps, for every
+// first letter, a 27-bit mask of the letters that can follow it in the trie
+// (bit 26 standing for "no next letter", set only when the first letter is a
+// word by itself). For a grid row it produces, for each of the 8 directions, a
+// bitmask of the start cells whose first two letters are a trie path; only
+// those cells need a walk. Rows are compared 32 or 16 cells at a time with
+// AVX2 or SSSE3 byte shuffles when the CPU has them, with a scalar fallback.
+class BigramFilter
+{
+public:
+    // How row masks are computed: Auto picks the widest kernel this CPU supports,
+    // Off marks every cell as a candidate
+    enum Kernel { Auto, Avx2, Ssse3, Scalar, Off };
+
+    BigramFilter();
+
+    // Collect the letter pairs that start a path in the trie. Words shorter than
+    // minWordLength are never reported, so a one-letter word only counts when it can be.
+    void build(const Trie& trie, int minWordLength);
+    void build(const FlatTrie& trie, int minWordLength);
+    void build(const Dawg& trie, int minWordLength);
+
+    // Candidate masks for grid row `row`: bit j of masks[d][j / 64] is set when a walk from
+    // (row, j) in direction d (gridDx/gridDy order) gets past its first letter.
+    // masks must hold 8 arrays of wordsPerRow(cols) words. codes is caller scratch.
+    void rowMasks(const std::vector<std::vector<char>>& grid, int row, int cols, std::vector<unsigned char>& codes, uint64_t* const masks[8]) const;
+
+    static size_t wordsPerRow(int cols) { return (static_cast<size_t>(cols) + 63) / 64; }
+
+    // Process-wide kernel choice; returns false, leaving the choice unchanged, if the CPU lacks it
+    static bool setKernel(Kernel kernel);
+    static Kernel activeKernel();  // Kernel rowMasks runs, never Auto
+    static const char* kernelName(Kernel kernel);
+
+private:
+    void prepareTables();  // Split follow into the byte tables the shuffle kernels look up
+
+    template <typename IndexTrie>
+    void buildIndexed(const IndexTrie& trie, int minWordLength);  // build for FlatTrie and Dawg
+
+    uint32_t follow[32];           // Letters that may follow each first letter; codes 26-31 never start a word
+    uint8_t followBytes[4][32];    // Byte k of follow[a] for every a, as shuffle tables
+};
+
+#endif // BIGRAMFILTER_H
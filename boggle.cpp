@@ -0,0 +1,300 @@
+/***************************************************************
+# boggle.cpp
+# Code implementing the free-path BoggleSearch with exhausted subtree pruning
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of BoggleSearch class
+# 2026.10.2    16.10.2026   Word counts taken from FlatTrie::countReportable
+# 2026.10.3    16.10.2026   Band count worked out in long long, so a huge thread count cannot overflow it
+# 2026.10.4    16.10.2026   Direction and letter code tables come from directions.h
+****************************************************************/
+
+#include "boggle.h"
+#include "directions.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+
+using namespace std;
+
+// Constructor
+BoggleSearch::BoggleSearch()
+    : stats(nullptr), pruning(true), rows(0), cols(0), width(0),
+      countedTrie(nullptr), countedNodes(0), countedMinLength(0), countedLongest(0)
+{
+    for (int d = 0; d < 8; d++)
+    {
+        offsets[d] = 0;
+    }
+}
+
+// Attach counters to later searches, nullptr turns counting off
+void BoggleSearch::setStats(SearchStats* searchStats)
+{
+    stats = searchStats;
+}
+
+// Count the reportable words below every node, when the trie or minimum length changed
+void BoggleSearch::prepareCounts(const FlatTrie& trie, int minWordLength)
+{
+    if (countedTrie == &trie && countedNodes == trie.nodeCount() && countedMinLength == minWordLength)
+    {
+        return;  // Same trie and settings as the last search
+    }
+
+    trie.countReportable(minWordLength, counts);
+    countedLongest = static_cast<int>(trie.maxWordLength());
+    countedTrie = &trie;
+    countedNodes = trie.nodeCount();
+    countedMinLength = minWordLength;
+    states.clear();  // Their counts were copied from the old ones
+}
+
+// Raise every count a search lowered and clear the words it reported
+void BoggleSearch::undo(ThreadState& state)
+{
+    for (uint32_t node : state.changed)
+    {
+        state.remaining[node]++;
+        state.reported[node >> 6] &= ~(uint64_t(1) << (node & 63));
+    }
+    state.changed.clear();
+}
+
+// Walk the free paths from each start cell in [cellBegin, cellEnd), with the counting compiled in only for <true>
+template <bool CountStats>
+void BoggleSearch::searchCells(const FlatTrie& trie, int minWordLength, int maxPath, int cellBegin, int cellEnd, ThreadState& state, BandResult& band) const
+{
+    vector<uint32_t>& remaining = state.remaining;
+    vector<uint64_t>& reported = state.reported;
+    uint64_t* visited = state.visited.data();
+    Frame* stack = state.stack.data();
+    const unsigned char* grid = codes.data();
+
+    for (int cell = cellBegin; cell < cellEnd; cell++)
+    {
+        if (pruning && remaining[0] == 0)
+        {
+            break;  // Every word has been reported
+        }
+
+        uint32_t start = static_cast<uint32_t>((cell / cols + 1) * width + cell % cols + 1);
+        unsigned char code = grid[start];
+        if (code >= 26)
+        {
+            continue;  // Not a letter, no word can start here
+        }
+        if (CountStats) band.stats.walksStarted++;
+
+        uint32_t node = trie.child(trie.root(), code);
+        if (node == 0 || (pruning && remaining[node] == 0))
+        {
+            if (CountStats && node != 0) band.stats.exhaustedPrunes++;
+            if (CountStats) band.stats.prunedAtDepthOne++;
+            continue;
+        }
+
+        int depth = 0;
+        bool extended = false;
+        Frame first = {start, node, 0};
+        stack[depth++] = first;
+        visited[start >> 6] |= uint64_t(1) << (start & 63);
+        if (CountStats) band.stats.trieSteps++;
+
+        while (true)
+        {
+            // A word ends at the top of the stack; report it the first time this thread sees it
+            if (depth > 0 && stack[depth - 1].dir == 0 && trie.isEndOfWord(stack[depth - 1].node))
+            {
+                uint32_t hitNode = stack[depth - 1].node;
+                bool seen = ((reported[hitNode >> 6] >> (hitNode & 63)) & 1) != 0;
+                if (CountStats)
+                {
+                    band.stats.hits++;
+                    if (depth < minWordLength) band.stats.rejectedMinLength++;
+                    else if (seen) band.stats.rejectedDuplicate++;
+                    else if (trie.isIgnored(hitNode)) band.stats.rejectedIgnored++;
+                    else band.stats.accepted++;
+                }
+                if (depth >= minWordLength && !seen && !trie.isIgnored(hitNode))
+                {
+                    reported[hitNode >> 6] |= uint64_t(1) << (hitNode & 63);
+                    remaining[0]--;
+                    state.changed.push_back(0);
+                    for (int k = 0; k < depth; k++)
+                    {
+                        remaining[stack[k].node]--;
+                        state.changed.push_back(stack[k].node);
+                    }
+
+                    BoggleHit hit;
+                    hit.node = hitNode;
+                    hit.startRow = static_cast<int32_t>(stack[0].cell / width);
+                    hit.startCol = static_cast<int32_t>(stack[0].cell % width);
+                    hit.endRow = static_cast<int32_t>(stack[depth - 1].cell / width);
+                    hit.endCol = static_cast<int32_t>(stack[depth - 1].cell % width);
+                    hit.textOffset = static_cast<uint32_t>(band.text.size());
+                    hit.length = static_cast<uint32_t>(depth);
+                    for (int k = 0; k < depth; k++)
+                    {
+                        band.text += static_cast<char>('A' + grid[stack[k].cell]);
+                    }
+                    band.hits.push_back(hit);
+                }
+            }
+
+            Frame& top = stack[depth - 1];
+            if (top.dir == 8 || depth >= maxPath || (pruning && remaining[top.node] == 0))
+            {
+                // Every neighbour tried, the path is at its cap, or nothing below is left to report
+                visited[top.cell >> 6] &= ~(uint64_t(1) << (top.cell & 63));
+                if (--depth == 0)
+                {
+                    break;
+                }
+                continue;
+            }
+
+            uint32_t next = top.cell + offsets[top.dir++];
+            if ((visited[next >> 6] >> (next & 63)) & 1)
+            {
+                continue;  // Already on the path
+            }
+            code = grid[next];
+            if (code >= 26 || (node = trie.child(top.node, code)) == 0)
+            {
+                continue;  // Border, not a letter, or no further path in the trie
+            }
+            if (pruning && remaining[node] == 0)
+            {
+                if (CountStats) band.stats.exhaustedPrunes++;
+                continue;
+            }
+
+            Frame frame = {next, node, 0};
+            stack[depth++] = frame;
+            visited[next >> 6] |= uint64_t(1) << (next & 63);
+            extended = true;
+            if (CountStats) band.stats.trieSteps++;
+        }
+
+        if (CountStats && !extended) band.stats.prunedAtDepthOne++;
+    }
+}
+
+// Search the grid, splitting the start cells into bands when more than one thread is requested
+vector<string> BoggleSearch::searchWords(const vector<vector<char>>& grid, const FlatTrie& trie, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, int minWordLength, int maxPathLength, int threads)
+{
+    vector<string> result;
+    if (grid.empty())
+    {
+        return result;
+    }
+
+    // Copy the grid into letter codes inside a border of non-letters, never past the shortest row
+    rows = static_cast<int>(grid.size());
+    cols = static_cast<int>(grid[0].size());
+    for (const auto& row : grid)
+    {
+        cols = min(cols, static_cast<int>(row.size()));
+    }
+    width = cols + 2;
+    codes.assign(static_cast<size_t>(rows + 2) * width, 26);
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            codes[static_cast<size_t>(r + 1) * width + c + 1] = letterCodes[static_cast<unsigned char>(grid[r][c])];
+        }
+    }
+    for (int d = 0; d < 8; d++)
+    {
+        offsets[d] = gridDx[d] * width + gridDy[d];
+    }
+
+    prepareCounts(trie, minWordLength);
+    int maxPath = maxPathLength > 0 ? min(maxPathLength, countedLongest) : countedLongest;
+    maxPath = min(maxPath, rows * cols);
+    if (maxPath <= 0)
+    {
+        return result;  // Empty trie or grid
+    }
+
+    int cells = rows * cols;
+    int bandCount = threads <= 1 ? 1 : static_cast<int>(min<long long>(cells, static_cast<long long>(threads) * 8));  // Several bands per thread to even out the work
+    int workers = min(max(threads, 1), bandCount);
+    bands.resize(bandCount);
+    states.resize(workers);
+    for (auto& state : states)
+    {
+        if (state.remaining.size() != counts.size())
+        {
+            state.remaining = counts;
+            state.reported.assign((counts.size() + 63) / 64, 0);
+        }
+        size_t visitedWords = (codes.size() + 63) / 64;
+        if (state.visited.size() != visitedWords)
+        {
+            state.visited.assign(visitedWords, 0);  // Every walk clears its own bits, so a same-sized bitset is clear
+        }
+        state.stack.resize(maxPath);
+    }
+
+    // Workers claim bands in increasing order and keep their counts across them,
+    // so a word a worker skips always has an earlier kept occurrence
+    atomic<int> nextBand(0);
+    auto worker = [&](int w)
+    {
+        for (int b = nextBand++; b < bandCount; b = nextBand++)
+        {
+            BandResult& band = bands[b];
+            band.hits.clear();
+            band.text.clear();
+            band.stats = SearchStats();
+            int cellBegin = static_cast<int>(static_cast<long long>(cells) * b / bandCount);
+            int cellEnd = static_cast<int>(static_cast<long long>(cells) * (b + 1) / bandCount);
+            if (stats) searchCells<true>(trie, minWordLength, maxPath, cellBegin, cellEnd, states[w], band);
+            else searchCells<false>(trie, minWordLength, maxPath, cellBegin, cellEnd, states[w], band);
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < workers; t++)
+    {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);  // The calling thread takes a share of the bands too
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+
+    // Merge in band order; a word seen in an earlier band wins, exactly as in one sequential pass
+    merged.assign((counts.size() + 63) / 64, 0);
+    for (const auto& band : bands)
+    {
+        if (stats) stats->add(band.stats);
+        for (const auto& hit : band.hits)
+        {
+            if ((merged[hit.node >> 6] >> (hit.node & 63)) & 1)
+            {
+                continue;
+            }
+            merged[hit.node >> 6] |= uint64_t(1) << (hit.node & 63);
+            string word = band.text.substr(hit.textOffset, hit.length);
+            result.push_back(word);
+            locations.push_back({word, {{hit.startRow, hit.startCol}, {hit.endRow, hit.endCol}}});  // Padded indices are already 1-based
+        }
+    }
+
+    for (auto& state : states)
+    {
+        undo(state);
+    }
+    return result;  // Return all unique found words
+}
@@ -0,0 +1,130 @@
+/***************************************************************
+# boggle.h
+# Header for boggle.cpp, defines the free-path BoggleSearch
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of BoggleSearch class
+# 2026.10.2    16.10.2026   Dropped the letterIndex member for the shared letterCodes table
+****************************************************************/
+
+#ifndef BOGGLE_H
+#define BOGGLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "flattrie.h"
+#include "searchstats.h"
+
+// BoggleSearch class definition.
+// Boggle-style search: a word may turn at any cell onto any of its 8 neighbours,
+// as long as no cell is used twice in the same word. Each walk is an iterative
+// DFS over the FlatTrie holding only a stack of (cell, node) frames, with the
+// cells on the current path kept in a visited bitset; word text is rebuilt from
+// the path only on a hit.
+//
+// The search reports the first occurrence of each word, so a branch is pruned
+// as soon as every reportable word in its trie subtree has been reported. Each
+// node carries a count of reportable words below it, and a report takes one
+// off the count of every node on its path. Once a small board's dictionary
+// has no more words to give, whole subtrees are skipped at their first letter.
+//
+// Ignore marks (FlatTrie::markIgnored) and minWordLength filter words as in the
+// straight-line engines. The per-node counts are kept between searches, so the
+// trie and its ignore marks must not change while a BoggleSearch is in use.
+class BoggleSearch
+{
+public:
+    BoggleSearch();
+
+    // Search the grid for words in the FlatTrie along free paths of at most maxPathLength
+    // cells (0 for no cap beyond the longest word). Each word is reported once, with the
+    // 1-based first and last cells of its first occurrence, in start cell order and then
+    // in the order the neighbours are tried (the 8 GridSearch directions).
+    // With threads > 1 the start cells are split into bands searched concurrently and
+    // merged in cell order, so the output does not depend on the thread count.
+    std::vector<std::string> searchWords(const std::vector<std::vector<char>>& grid, const FlatTrie& trie, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, int minWordLength, int maxPathLength = 0, int threads = 1);
+
+    // Turn the exhausted subtree pruning on or off (on by default), to measure what it saves
+    void setPruning(bool enabled) { pruning = enabled; }
+
+    // Count walks, trie steps and hit outcomes of later searches into searchStats.
+    // Pass nullptr (the default) to search without any counting overhead.
+    void setStats(SearchStats* searchStats);
+
+private:
+    // One reported word: its end-of-word node, first and last cells and its text in the band's text
+    struct BoggleHit
+    {
+        uint32_t node;
+        int32_t startRow;
+        int32_t startCol;
+        int32_t endRow;
+        int32_t endCol;
+        uint32_t textOffset;
+        uint32_t length;
+    };
+
+    // Hits of one band of start cells, kept apart until the final merge
+    struct BandResult
+    {
+        std::vector<BoggleHit> hits;
+        std::string text;  // Words of the hits, back to back
+        SearchStats stats;
+    };
+
+    // A cell on the current path and the trie node reached there
+    struct Frame
+    {
+        uint32_t cell;
+        uint32_t node;
+        int dir;  // Next neighbour to try
+    };
+
+    // Everything one search thread changes, kept between searches
+    struct ThreadState
+    {
+        std::vector<uint32_t> remaining;  // Reportable words below each node not yet reported by this thread
+        std::vector<uint64_t> reported;  // Words reported by this thread, one bit per node
+        std::vector<uint64_t> visited;  // Cells on the current path, one bit per padded cell
+        std::vector<Frame> stack;  // Current path
+        std::vector<uint32_t> changed;  // Nodes whose remaining count was lowered, to undo after the search
+    };
+
+    // Count the reportable words below every node, when the trie or minimum length changed
+    void prepareCounts(const FlatTrie& trie, int minWordLength);
+
+    // Walk every start cell in [cellBegin, cellEnd) into band, with or without counters
+    template <bool CountStats>
+    void searchCells(const FlatTrie& trie, int minWordLength, int maxPath, int cellBegin, int cellEnd, ThreadState& state, BandResult& band) const;
+
+    // Put a thread's counts and bits back as prepareCounts left them
+    static void undo(ThreadState& state);
+
+    SearchStats* stats;  // Counters for the current search, or nullptr
+    bool pruning;  // Skip subtrees with nothing left to report
+
+    // Grid of the current search as letter codes, with a border of 26 all round so no walk needs a bounds check
+    std::vector<unsigned char> codes;
+    int rows;
+    int cols;
+    int width;  // cols + 2, the padded row length
+    int offsets[8];  // Padded index step to each neighbour, in GridSearch direction order
+
+    const FlatTrie* countedTrie;  // Trie and settings the counts below were made for
+    size_t countedNodes;
+    int countedMinLength;
+    int countedLongest;  // Letters in the longest word
+    std::vector<uint32_t> counts;  // Reportable words below each node, the starting value of remaining
+
+    std::vector<ThreadState> states;  // One per search thread
+    std::vector<BandResult> bands;  // Per-band results, reused between searches
+    std::vector<uint64_t> merged;  // Words taken by the merge, one bit per node
+};
+
+#endif // BOGGLE_H
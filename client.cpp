@@ -0,0 +1,255 @@
+/***************************************************************
+# client.cpp
+# Command-line client and load tester for the GridLex socket server
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial version, search, stats and load commands
+****************************************************************/
+
+#include "gridsearch.h"
+#include "unixsocket.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Display help information for the client
+static void displayHelp()
+{
+    cout << "Usage: ./gridlex_client <socket_path> search <csv_grid_file> [name]\n"
+         << "       ./gridlex_client <socket_path> stats\n"
+         << "       ./gridlex_client <socket_path> load <csv_grid_file> [options]\n"
+         << "Commands:\n"
+         << "  search                       Send one grid and print the JSON result\n"
+         << "  stats                        Print the server's request counts and latency percentiles\n"
+         << "  load                         Send the grid repeatedly from concurrent connections and\n"
+         << "                               print client-side latency percentiles as JSON\n"
+         << "Load options:\n"
+         << "  --clients <n>                Concurrent connections (default: 8)\n"
+         << "  --requests <n>               Timed requests per connection (default: 1000)\n"
+         << "  --warmup <n>                 Untimed requests per connection first (default: 10)\n"
+         << endl;
+}
+
+// Build a SEARCH request for a grid: header line, one CSV line per row, then an empty line
+static string searchRequest(const vector<vector<char>>& grid, const string& name)
+{
+    string request = name.empty() ? "SEARCH\n" : "SEARCH " + name + "\n";
+    for (const auto& row : grid)
+    {
+        for (size_t j = 0; j < row.size(); j++)
+        {
+            if (j > 0) request += ',';
+            request += row[j];
+        }
+        request += '\n';
+    }
+    request += '\n';
+    return request;
+}
+
+// Send one request on a new connection and return the single response line
+static bool sendOnce(const string& socketPath, const string& request, string& response)
+{
+    SocketStream stream(connectUnixSocket(socketPath));
+    if (stream.fd() < 0)
+    {
+        cerr << "Error: Could not connect to " << socketPath << endl;
+        return false;
+    }
+    return stream.writeAll(request) && stream.readLine(response);
+}
+
+// Value at quantile q (0 to 1) of a sorted sample, nearest rank
+static double sortedQuantile(const vector<double>& sorted, double q)
+{
+    size_t rank = static_cast<size_t>(q * sorted.size() + 0.999999);
+    rank = min(max(rank, static_cast<size_t>(1)), sorted.size());
+    return sorted[rank - 1];
+}
+
+// Drive the server from several connections at once and report the latency distribution
+static int runLoad(const string& socketPath, const string& request, int clients, int requests, int warmup)
+{
+    vector<vector<double>> perClient(clients);
+    vector<size_t> errors(clients, 0);
+    vector<bool> connected(clients, false);
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int c = 0; c < clients; c++)
+    {
+        pool.emplace_back([&, c]()
+        {
+            SocketStream stream(connectUnixSocket(socketPath));
+            if (stream.fd() < 0)
+            {
+                return;
+            }
+            connected[c] = true;
+            perClient[c].reserve(requests);
+
+            string response;
+            for (int r = 0; r < warmup + requests; r++)
+            {
+                auto sent = chrono::steady_clock::now();
+                if (!stream.writeAll(request) || !stream.readLine(response))
+                {
+                    errors[c] += warmup + requests - r;
+                    return;
+                }
+                double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - sent).count();
+                if (response.find("\"error\"") != string::npos)
+                {
+                    errors[c]++;
+                }
+                if (r >= warmup)
+                {
+                    perClient[c].push_back(ms);
+                }
+            }
+        });
+    }
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<double> all;
+    size_t errorCount = 0;
+    int connectedCount = 0;
+    for (int c = 0; c < clients; c++)
+    {
+        all.insert(all.end(), perClient[c].begin(), perClient[c].end());
+        errorCount += errors[c];
+        connectedCount += connected[c] ? 1 : 0;
+    }
+    if (all.empty())
+    {
+        cerr << "Error: No requests completed against " << socketPath << endl;
+        return 1;
+    }
+    sort(all.begin(), all.end());
+    double total = 0;
+    for (double ms : all)
+    {
+        total += ms;
+    }
+
+    string serverStats;
+    sendOnce(socketPath, "STATS\n", serverStats);
+
+    cout << "{\"clients\": " << clients << ", \"connected\": " << connectedCount << ", \"requests\": " << all.size()
+         << ", \"errors\": " << errorCount << ", \"elapsed_s\": " << elapsed
+         << ", \"requests_per_s\": " << (warmup + requests) * static_cast<double>(connectedCount) / elapsed
+         << ", \"latency_ms\": {\"p50\": " << sortedQuantile(all, 0.5) << ", \"p90\": " << sortedQuantile(all, 0.9)
+         << ", \"p99\": " << sortedQuantile(all, 0.99) << ", \"p999\": " << sortedQuantile(all, 0.999)
+         << ", \"max\": " << all.back() << ", \"mean\": " << total / all.size() << "}"
+         << ", \"server\": " << (serverStats.empty() ? "null" : serverStats) << "}" << endl;
+    return errorCount == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3 || strcmp(argv[1], "-h") == 0)
+    {
+        displayHelp();
+        return argc < 3 ? 1 : 0;
+    }
+    if (!unixSocketsSupported())
+    {
+        cerr << "Error: Unix domain sockets are not supported on this platform." << endl;
+        return 1;
+    }
+
+    string socketPath = argv[1];
+    string command = argv[2];
+
+    if (command == "stats")
+    {
+        string response;
+        if (!sendOnce(socketPath, "STATS\n", response))
+        {
+            return 1;
+        }
+        cout << response << endl;
+        return 0;
+    }
+
+    if (command != "search" && command != "load")
+    {
+        cerr << "Error: Unknown command " << command << ". Use search, stats or load." << endl;
+        return 1;
+    }
+    if (argc < 4)
+    {
+        cerr << "Error: No grid file specified for " << command << "." << endl;
+        return 1;
+    }
+
+    vector<vector<char>> grid = readCSVFile(argv[3]);
+    if (grid.empty())
+    {
+        cerr << "Error: Grid could not be loaded from CSV file." << endl;
+        return 1;
+    }
+
+    if (command == "search")
+    {
+        string response;
+        if (!sendOnce(socketPath, searchRequest(grid, argc > 4 ? argv[4] : ""), response))
+        {
+            return 1;
+        }
+        cout << response << endl;
+        return 0;
+    }
+
+    int clients = 8;
+    int requests = 1000;
+    int warmup = 10;
+    for (int i = 4; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            cerr << "Error: No value specified after " << arg << "." << endl;
+            return 1;
+        }
+        try
+        {
+            if (arg == "--clients") clients = stoi(argv[++i]);
+            else if (arg == "--requests") requests = stoi(argv[++i]);
+            else if (arg == "--warmup") warmup = stoi(argv[++i]);
+            else
+            {
+                cerr << "Error: Unknown option " << arg << endl;
+                return 1;
+            }
+        }
+        catch (const exception& e)
+        {
+            cerr << "Error: Invalid value " << argv[i] << " for " << arg << "." << endl;
+            return 1;
+        }
+    }
+    if (clients <= 0 || requests <= 0 || warmup < 0)
+    {
+        cerr << "Error: --clients and --requests must be positive." << endl;
+        return 1;
+    }
+
+    return runLoad(socketPath, searchRequest(grid, "load"), clients, requests, warmup);
+}
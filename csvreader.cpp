@@ -0,0 +1,133 @@
+/***************************************************************
+# csvreader.cpp
+# Code implementing a single-pass CSV tokenizer over a memory-mapped file
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of CSVReader class
+# 2026.10.2    15.10.2026   Added line access and readCells for grid rows
+# 2026.10.3    15.10.2026   Added parseCells for grid rows held in memory
+# 2026.10.4    15.10.2026   Added offset and releaseConsumed for streaming reads
+****************************************************************/
+
+#include "csvreader.h"
+#include <cctype>
+#include <cstring>
+
+using namespace std;
+
+// Constructor, nothing to read until a file is opened
+CSVReader::CSVReader()
+    : cursor(nullptr), fileEnd(nullptr), lineStart(nullptr), field(nullptr), lineEnd(nullptr), fieldsLeft(false), released(0)
+{
+}
+
+// Map the file and step over a UTF-8 byte order mark, if there is one
+bool CSVReader::open(const string& filename)
+{
+    fieldsLeft = false;
+    released = 0;
+    if (!mapped.open(filename))
+    {
+        cursor = fileEnd = nullptr;
+        return false;
+    }
+
+    cursor = mapped.data();
+    fileEnd = cursor + mapped.size();
+    if (mapped.size() >= 3 && memcmp(cursor, "\xEF\xBB\xBF", 3) == 0)
+    {
+        cursor += 3;
+    }
+    return true;
+}
+
+// Find the end of the next line and make its fields available
+bool CSVReader::nextLine()
+{
+    if (cursor == fileEnd)
+    {
+        fieldsLeft = false;
+        return false;
+    }
+
+    const char* newline = static_cast<const char*>(memchr(cursor, '\n', fileEnd - cursor));
+    lineStart = field = cursor;
+    lineEnd = newline ? newline : fileEnd;
+    cursor = newline ? newline + 1 : fileEnd;
+    if (lineEnd > lineStart && lineEnd[-1] == '\r')
+    {
+        lineEnd--;  // CRLF line ending
+    }
+    fieldsLeft = true;
+    return true;
+}
+
+// Hand out the field up to the next comma, or up to the end of the line
+bool CSVReader::nextField(const char*& begin, const char*& end)
+{
+    if (!fieldsLeft)
+    {
+        return false;
+    }
+
+    const char* comma = static_cast<const char*>(memchr(field, ',', lineEnd - field));
+    begin = field;
+    if (comma)
+    {
+        end = comma;
+        field = comma + 1;
+    }
+    else
+    {
+        end = lineEnd;
+        fieldsLeft = false;
+    }
+    return true;
+}
+
+// Release the mapped pages before the current line; its fields may still be read
+void CSVReader::releaseConsumed()
+{
+    if (lineStart == nullptr)
+    {
+        return;
+    }
+    size_t end = static_cast<size_t>(lineStart - mapped.data());
+    if (end > released)
+    {
+        mapped.release(released, end);
+        released = end;
+    }
+}
+
+// Take one upper cased character from each non-empty field left on the line
+void CSVReader::readCells(vector<char>& row)
+{
+    if (fieldsLeft)
+    {
+        parseCells(field, lineEnd, row);
+        fieldsLeft = false;
+    }
+}
+
+// Take one upper cased character from each non-empty comma separated field of [begin, end)
+void CSVReader::parseCells(const char* begin, const char* end, vector<char>& row)
+{
+    bool fieldStart = true;  // The next character is the first of its field
+    for (const char* c = begin; c != end; c++)
+    {
+        if (*c == ',')
+        {
+            fieldStart = true;
+        }
+        else if (fieldStart)
+        {
+            row.push_back(static_cast<char>(toupper(static_cast<unsigned char>(*c))));
+            fieldStart = false;
+        }
+    }
+}
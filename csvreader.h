@@ -0,0 +1,76 @@
+/***************************************************************
+# csvreader.h
+# Header for csvreader.cpp, defines the zero-copy CSVReader
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of CSVReader class
+# 2026.10.2    15.10.2026   Added line access and readCells for grid rows
+# 2026.10.3    15.10.2026   Added parseCells for grid rows held in memory
+# 2026.10.4    15.10.2026   Added offset and releaseConsumed for streaming reads
+****************************************************************/
+
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "mappedfile.h"
+
+// CSVReader class definition.
+// Walks a memory-mapped CSV file line by line and field by field without copying:
+// each field is handed out as a pointer range into the mapping. A leading UTF-8
+// byte order mark is skipped and a carriage return before each newline is dropped,
+// so files saved on Windows read the same as Unix ones.
+//
+// Usage:
+//     while (reader.nextLine())
+//         while (reader.nextField(begin, end)) ...
+class CSVReader
+{
+public:
+    CSVReader();
+
+    bool open(const std::string& filename);  // Map the file, returns false if it cannot be opened
+    size_t size() const { return mapped.size(); }  // Bytes in the file, including any byte order mark
+
+    // Move to the next line, returns false at the end of the file
+    bool nextLine();
+
+    // Return the next comma separated field of the current line as [begin, end),
+    // returns false once the line has no more fields. Fields may be empty.
+    bool nextField(const char*& begin, const char*& end);
+
+    // Append the first character of each non-empty remaining field, upper cased, to row.
+    // This is how grid files are read: one letter per cell.
+    void readCells(std::vector<char>& row);
+
+    // Same as readCells for a line already in memory, such as one received over a socket
+    static void parseCells(const char* begin, const char* end, std::vector<char>& row);
+
+    // Bytes of the file consumed so far, up to the start of the next line
+    size_t offset() const { return cursor ? static_cast<size_t>(cursor - mapped.data()) : 0; }
+
+    // Let the OS drop the pages of every line before the current one, so a long
+    // sequential read does not keep the whole file resident
+    void releaseConsumed();
+
+    const char* line() const { return lineStart; }  // Start of the current line
+    size_t lineSize() const { return lineEnd - lineStart; }  // Length of the current line, line ending excluded
+
+private:
+    MappedFile mapped;
+    const char* cursor;    // Start of the next line
+    const char* fileEnd;   // One past the last byte of the file
+    const char* lineStart; // Start of the current line
+    const char* field;     // Start of the next field on the current line
+    const char* lineEnd;   // End of the current line, carriage return excluded
+    bool fieldsLeft;       // True until the last field of the current line is returned
+    size_t released;       // Bytes from the start of the file already handed back by releaseConsumed
+};
+
+#endif // CSVREADER_H
@@ -0,0 +1,225 @@
+/***************************************************************
+# dawg.cpp
+# Code implementing the minimised Dawg dictionary, built from a sorted word list
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of Dawg class
+****************************************************************/
+
+#include "dawg.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+using namespace std;
+
+// Starting number of register slots, a power of two
+static const size_t initialRegistry = 1 << 16;
+
+// Constructor, just the root
+Dawg::Dawg()
+    : registered(0), words(0), longest(0)
+{
+    clear();
+}
+
+// Forget every word, leaving a root with no children
+void Dawg::clear()
+{
+    nodes.assign(1, DawgNode());
+    nodes[0].firstEdge = 0;
+    nodes[0].letters = 0;
+    edges.clear();
+    words = 0;
+    longest = 0;
+}
+
+// Bytes held by the nodes and edges
+size_t Dawg::bytes() const
+{
+    return nodes.capacity() * sizeof(DawgNode) + edges.capacity() * sizeof(uint32_t);
+}
+
+// Hash a node by its letter mask and children, the same way for open and frozen nodes
+uint64_t Dawg::hashNode(uint32_t letters, const uint32_t* children, uint32_t count)
+{
+    uint64_t hash = letters * 0x9E3779B97F4A7C15ull;
+    for (uint32_t k = 0; k < count; k++)
+    {
+        hash = (hash ^ children[k]) * 0x9E3779B97F4A7C15ull;
+    }
+    return hash ^ (hash >> 29);
+}
+
+// Double the register and put every frozen node back in
+void Dawg::growRegister()
+{
+    registry.assign(registry.size() * 2, 0);
+    size_t mask = registry.size() - 1;
+    for (uint32_t id = 1; id < nodes.size(); id++)
+    {
+        const DawgNode& node = nodes[id];
+        size_t slot = hashNode(node.letters, edges.data() + node.firstEdge, countBits(node.letters & ~endOfWordBit)) & mask;
+        while (registry[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        registry[slot] = id;
+    }
+}
+
+// Find a frozen node with the same end mark and the same children, or freeze this one
+uint32_t Dawg::freeze(const OpenNode& open)
+{
+    uint32_t children[26];
+    uint32_t count = 0;
+    for (int index = 0; index < 26; index++)
+    {
+        if (open.letters & (uint32_t(1) << index))
+        {
+            children[count++] = open.children[index];
+        }
+    }
+
+    size_t mask = registry.size() - 1;
+    size_t slot = hashNode(open.letters, children, count) & mask;
+    while (registry[slot] != 0)
+    {
+        const DawgNode& candidate = nodes[registry[slot]];
+        if (candidate.letters == open.letters && memcmp(edges.data() + candidate.firstEdge, children, count * sizeof(uint32_t)) == 0)
+        {
+            return registry[slot];  // An equal subtree already exists, share it
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    uint32_t id = static_cast<uint32_t>(nodes.size());
+    DawgNode node;
+    node.firstEdge = static_cast<uint32_t>(edges.size());
+    node.letters = open.letters;
+    nodes.push_back(node);
+    edges.insert(edges.end(), children, children + count);
+
+    registry[slot] = id;
+    if (++registered * 2 > registry.size())
+    {
+        growRegister();  // Keep the register at most half full
+    }
+    return id;
+}
+
+// Freeze the open nodes of word deeper than depth; no later word in sorted order can extend them
+void Dawg::closePath(vector<OpenNode>& path, const string& word, size_t depth)
+{
+    for (size_t k = word.size(); k > depth; k--)
+    {
+        path[k - 1].children[word[k - 1] - 'A'] = freeze(path[k]);
+    }
+}
+
+// Build the graph from the sorted, distinct, upper cased words
+void Dawg::build(vector<string> list)
+{
+    clear();
+
+    // Same normalisation as Trie::insert: letters only, upper cased
+    for (auto& word : list)
+    {
+        size_t kept = 0;
+        for (char c : word)
+        {
+            if (isalpha(static_cast<unsigned char>(c)))
+            {
+                word[kept++] = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+            }
+        }
+        word.resize(kept);
+    }
+    sort(list.begin(), list.end());
+    list.erase(unique(list.begin(), list.end()), list.end());
+
+    registry.assign(initialRegistry, 0);
+    registered = 0;
+    vector<OpenNode> path(1);  // Open nodes along the last word, path[0] being the root
+    memset(&path[0], 0, sizeof(OpenNode));
+    string previous;
+
+    for (const string& word : list)
+    {
+        size_t common = 0;
+        while (common < previous.size() && common < word.size() && previous[common] == word[common])
+        {
+            common++;
+        }
+        closePath(path, previous, common);
+
+        // Open fresh nodes for the rest of the word
+        if (path.size() < word.size() + 1)
+        {
+            path.resize(word.size() + 1);
+        }
+        for (size_t k = common; k < word.size(); k++)
+        {
+            memset(&path[k + 1], 0, sizeof(OpenNode));
+            path[k].letters |= uint32_t(1) << (word[k] - 'A');
+        }
+        path[word.size()].letters |= endOfWordBit;
+
+        longest = max(longest, word.size());
+        previous = word;
+    }
+    closePath(path, previous, 0);
+
+    // The root is never anyone's child, so it goes in slot 0 rather than the register
+    const OpenNode& open = path[0];
+    nodes[0].firstEdge = static_cast<uint32_t>(edges.size());
+    nodes[0].letters = open.letters;
+    for (int index = 0; index < 26; index++)
+    {
+        if (open.letters & (uint32_t(1) << index))
+        {
+            edges.push_back(open.children[index]);
+        }
+    }
+
+    words = list.size();
+    vector<uint32_t>().swap(registry);  // Only needed while building
+    nodes.shrink_to_fit();
+    edges.shrink_to_fit();
+}
+
+// Search for a complete word
+bool Dawg::search(const string& word) const
+{
+    uint32_t node = root();
+    for (char c : word)
+    {
+        if (!isalpha(static_cast<unsigned char>(c))) continue;  // Skip non-alphabetic characters, as build does
+        node = child(node, toupper(static_cast<unsigned char>(c)) - 'A');
+        if (node == 0)
+        {
+            return false;
+        }
+    }
+    return isEndOfWord(node);
+}
+
+// Check whether any word starts with prefix
+bool Dawg::startsWith(const string& prefix) const
+{
+    uint32_t node = root();
+    for (char c : prefix)
+    {
+        if (!isalpha(static_cast<unsigned char>(c))) continue;
+        node = child(node, toupper(static_cast<unsigned char>(c)) - 'A');
+        if (node == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
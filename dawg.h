@@ -0,0 +1,107 @@
+/***************************************************************
+# dawg.h
+# Header for dawg.cpp, defines the minimised Dawg dictionary
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of Dawg class
+****************************************************************/
+
+#ifndef DAWG_H
+#define DAWG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// DawgNode structure, one node of a Dawg.
+// letters has bit i set when the node has a child for letter 'A' + i, and bit 31
+// set when a word ends here. The children's node indices sit in the edge array
+// from firstEdge on, one per set letter bit, in letter order.
+struct DawgNode
+{
+    uint32_t firstEdge;
+    uint32_t letters;
+};
+
+// Dawg class definition.
+// A minimised directed acyclic word graph: a trie in which every set of equal
+// subtrees, such as the endings shared by thousands of words (-ING, -TION, -ED),
+// is stored once. It is built in one pass over the sorted word list, freezing
+// each node as soon as no later word can add to it and merging it with an equal
+// node frozen earlier. Children are stored sparsely, 4 bytes per edge, found
+// with a bit count over the node's letter mask.
+//
+// Lookups use the same index interface as FlatTrie (root, child, isEndOfWord),
+// so GridSearch can walk either. Because end nodes are shared between words, a
+// node does not identify a word; GridSearch rebuilds word text as it walks, but
+// the node-indexed scan and ac engines cannot run on a Dawg.
+class Dawg
+{
+public:
+    static const uint32_t endOfWordBit = 0x80000000u;
+
+    Dawg();  // Constructor, an empty dictionary
+
+    // Build from a word list in any order. As with Trie::insert, characters other than
+    // A-Z and a-z are dropped and letters are upper cased. Any earlier words are replaced.
+    void build(std::vector<std::string> words);
+    void clear();  // Forget every word
+
+    bool search(const std::string& word) const;  // Check for a complete word, any case
+    bool startsWith(const std::string& prefix) const;  // Check for a prefix of some word, any case
+
+    size_t nodeCount() const { return nodes.size(); }  // Number of nodes including the root
+    size_t edgeCount() const { return edges.size(); }  // Number of parent to child links
+    size_t wordCount() const { return words; }  // Distinct words built from
+    size_t bytes() const;  // Bytes held by the nodes and edges
+    size_t maxWordLength() const { return longest; }  // Letters in the longest word, 0 when empty
+
+    // Node accessors used by GridSearch to walk the graph by index; 0 means no child
+    uint32_t root() const { return 0; }
+    uint32_t child(uint32_t node, int index) const
+    {
+        uint32_t letters = nodes[node].letters;
+        uint32_t bit = uint32_t(1) << index;
+        return (letters & bit) ? edges[nodes[node].firstEdge + countBits(letters & (bit - 1))] : 0;
+    }
+    bool isEndOfWord(uint32_t node) const { return (nodes[node].letters & endOfWordBit) != 0; }
+
+private:
+    // A node of the word being added, still open to new children
+    struct OpenNode
+    {
+        uint32_t letters;
+        uint32_t children[26];
+    };
+
+    // Number of set bits, without relying on a POPCNT instruction
+    static uint32_t countBits(uint32_t bits)
+    {
+        bits = bits - ((bits >> 1) & 0x55555555u);
+        bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+        return (((bits + (bits >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+    }
+
+    // Close the open nodes below depth along word, deepest first, linking each into its parent
+    void closePath(std::vector<OpenNode>& path, const std::string& word, size_t depth);
+
+    // Index of a frozen node equal to open, adding it when there is none
+    uint32_t freeze(const OpenNode& open);
+
+    static uint64_t hashNode(uint32_t letters, const uint32_t* children, uint32_t count);
+    void growRegister();  // Double the register and rehash every frozen node
+
+    std::vector<DawgNode> nodes;  // Frozen nodes, nodes[0] is the root
+    std::vector<uint32_t> edges;  // Child node indices of every node, node after node
+    std::vector<uint32_t> registry;  // Open-addressed hash of frozen nodes while building, 0 for an empty slot
+    size_t registered;  // Frozen nodes in registry
+    size_t words;
+    size_t longest;
+};
+
+#endif // DAWG_H
@@ -0,0 +1,25 @@
+/***************************************************************
+# directions.h
+# Header for directions.cpp, declares the grid directions and letter codes shared by the search engines
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    16.10.2026   Initial version of gridDx, gridDy and letterCodes
+****************************************************************/
+
+#ifndef DIRECTIONS_H
+#define DIRECTIONS_H
+
+// Row and column step of each of the 8 directions, indexed 0-7 by every engine,
+// WordHit::dir and the result writers. Direction (d + 4) % 8 is the reverse of d.
+extern const int gridDx[8];
+extern const int gridDy[8];
+
+// Code of a grid or word byte: 0-25 for A-Z in either case, notLetterCode for anything else
+extern const unsigned char letterCodes[256];
+const unsigned char notLetterCode = 26;
+
+#endif // DIRECTIONS_H
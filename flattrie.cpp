@@ -0,0 +1,416 @@
+/***************************************************************
+# flattrie.cpp
+# Code implementing an arena-backed Trie with 32-bit node indices
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of FlatTrie class
+# 2026.10.2    15.10.2026   Compiled dictionary files, saved and memory-mapped
+# 2026.10.3    15.10.2026   Ignore list marked per node in a bitset
+# 2026.10.4    15.10.2026   Added maxWordLength
+# 2026.10.5    16.10.2026   Added countReportable, per-node counts of reportable words
+# 2026.10.6    16.10.2026   isCompiledFile leaves pipes unread
+# 2026.10.7    16.10.2026   loadCompiled rejects child indices outside the pool or not after their parent
+# 2026.10.8    16.10.2026   reserve detaches a mapped pool and keeps base on the owned pool
+****************************************************************/
+
+#include "flattrie.h"
+#include <algorithm> // For max
+#include <cctype>   // For isalpha and toupper
+#include <cstring>  // For memset, memcpy and memcmp
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <sys/stat.h>  // For stat, to tell regular files from pipes
+
+using namespace std;
+
+// Compiled dictionary file layout: this header followed by the raw node pool
+struct CompiledHeader
+{
+    char magic[8];       // compiledMagic
+    uint32_t version;    // compiledVersion, bumped whenever the layout changes
+    uint32_t byteOrder;  // compiledByteOrder as written by the compiling machine
+    uint32_t nodeSize;   // sizeof(FlatTrieNode) on the compiling machine
+    uint32_t reserved;   // Always 0, keeps the node pool 8-byte aligned
+    uint64_t nodeCount;  // Number of nodes in the pool
+    uint64_t checksum;   // poolChecksum of the node pool
+};
+
+static const char compiledMagic[8] = {'G', 'L', 'X', 'D', 'I', 'C', 'T', '\0'};
+static const uint32_t compiledVersion = 1;
+static const uint32_t compiledByteOrder = 0x01020304;
+
+// 64-bit checksum of the node pool, eight bytes per step so verifying a mapped file stays cheap
+static uint64_t poolChecksum(const char* data, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++)
+    {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Constructor to initialize the pool with the root node
+FlatTrie::FlatTrie()
+    : base(nullptr), count(0)
+{
+    newNode();
+}
+
+// Move constructor, takes over the pool or mapping and leaves other empty
+FlatTrie::FlatTrie(FlatTrie&& other)
+    : base(nullptr), count(0)
+{
+    *this = std::move(other);
+}
+
+// Move assignment, takes over the pool or mapping and leaves other empty
+FlatTrie& FlatTrie::operator=(FlatTrie&& other)
+{
+    if (this != &other)
+    {
+        nodes = std::move(other.nodes);
+        mapped = std::move(other.mapped);
+        ignored = std::move(other.ignored);
+        base = other.base;  // Moving a vector keeps its buffer, so base stays valid
+        count = other.count;
+        other.clear();
+    }
+    return *this;
+}
+
+// Append a zeroed node to the pool and return its index
+uint32_t FlatTrie::newNode()
+{
+    if (nodes.size() >= UINT32_MAX)
+    {
+        throw length_error("FlatTrie node pool exceeds 32-bit index range");
+    }
+
+    FlatTrieNode node;
+    memset(&node, 0, sizeof(node));
+    nodes.push_back(node);
+    base = nodes.data();
+    count = nodes.size();
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+// Copy a mapped pool into owned memory so it can be modified
+void FlatTrie::detach()
+{
+    if (mapped.isOpen())
+    {
+        nodes.assign(base, base + count);
+        mapped.close();
+        base = nodes.data();
+    }
+}
+
+// Drop the whole pool in one deallocation and start again with an empty root
+void FlatTrie::clear()
+{
+    vector<FlatTrieNode>().swap(nodes);
+    vector<uint64_t>().swap(ignored);
+    mapped.close();
+    newNode();
+}
+
+// Bytes held by the pool, or mapped from a compiled file
+size_t FlatTrie::bytes() const
+{
+    if (mapped.isOpen())
+    {
+        return mapped.size();
+    }
+    return nodes.capacity() * sizeof(FlatTrieNode);
+}
+
+// Depth of the deepest end-of-word node, found with an explicit stack so long words cannot overflow the call stack
+size_t FlatTrie::maxWordLength() const
+{
+    size_t longest = 0;
+    vector<pair<uint32_t, uint32_t>> pending = {{root(), 0}};  // Node and its depth
+    while (!pending.empty())
+    {
+        uint32_t node = pending.back().first;
+        uint32_t depth = pending.back().second;
+        pending.pop_back();
+
+        if (base[node].isEndOfWord)
+        {
+            longest = max(longest, static_cast<size_t>(depth));
+        }
+        for (int c = 0; c < 26; c++)
+        {
+            if (base[node].children[c] != 0)
+            {
+                pending.push_back({base[node].children[c], depth + 1});
+            }
+        }
+    }
+    return longest;
+}
+
+// Count the reportable words below every node. Children always come after their parent
+// in the pool, so depths fill in going forwards and counts going backwards.
+void FlatTrie::countReportable(int minWordLength, vector<uint32_t>& counts) const
+{
+    vector<uint32_t> depth(count, 0);
+    for (size_t node = 0; node < count; node++)
+    {
+        for (int c = 0; c < 26; c++)
+        {
+            uint32_t next = base[node].children[c];
+            if (next != 0)
+            {
+                depth[next] = depth[node] + 1;
+            }
+        }
+    }
+
+    counts.assign(count, 0);
+    for (size_t node = count; node-- > 0;)
+    {
+        uint32_t below = 0;
+        for (int c = 0; c < 26; c++)
+        {
+            uint32_t next = base[node].children[c];
+            if (next != 0)
+            {
+                below += counts[next];
+            }
+        }
+        bool reportable = base[node].isEndOfWord && depth[node] >= static_cast<uint32_t>(minWordLength) && !isIgnored(static_cast<uint32_t>(node));
+        counts[node] = below + (reportable ? 1 : 0);
+    }
+}
+
+// Reserve room for nodeCapacity nodes so large dictionaries load without regrowth
+void FlatTrie::reserve(size_t nodeCapacity)
+{
+    detach();
+    nodes.reserve(nodeCapacity);
+    base = nodes.data();  // Reserving may have moved the pool
+}
+
+// Insert a word into the FlatTrie, skipping non-alphabetic characters
+void FlatTrie::insert(const string& word)
+{
+    detach();
+    uint32_t node = root();
+    for (char c : word)
+    {
+        // Check if the character is an alphabetic letter
+        if (isalpha(static_cast<unsigned char>(c)))
+        {
+            int index = toupper(static_cast<unsigned char>(c)) - 'A';  // Convert to uppercase and get index in range 0-25
+            if (nodes[node].children[index] == 0)
+            {
+                uint32_t created = newNode();  // May reallocate the pool, so index again below
+                nodes[node].children[index] = created;
+            }
+            node = nodes[node].children[index];
+        }
+    }
+    nodes[node].isEndOfWord = true;  // Mark the end of the word
+}
+
+// Mark the end-of-word node of every ignore word that is in the FlatTrie
+void FlatTrie::markIgnored(const set<string>& words)
+{
+    ignored.assign((count + 63) / 64, 0);
+    for (const string& word : words)
+    {
+        uint32_t node = root();
+        bool inTrie = !word.empty();
+        for (char c : word)
+        {
+            // Grid text is upper case letters only, so nothing else can ever be matched
+            if (c < 'A' || c > 'Z' || base[node].children[c - 'A'] == 0)
+            {
+                inTrie = false;
+                break;
+            }
+            node = base[node].children[c - 'A'];
+        }
+
+        if (inTrie && base[node].isEndOfWord)
+        {
+            ignored[node >> 6] |= uint64_t(1) << (node & 63);
+        }
+    }
+}
+
+// Forget every ignore mark
+void FlatTrie::clearIgnored()
+{
+    vector<uint64_t>().swap(ignored);
+}
+
+// Search for a complete word in the FlatTrie, handling both upper and lowercase input
+bool FlatTrie::search(const string& word) const
+{
+    uint32_t node = root();
+    for (char c : word)
+    {
+        if (!isalpha(static_cast<unsigned char>(c))) continue;  // Skip non-alphabetic characters
+        int index = toupper(static_cast<unsigned char>(c)) - 'A';
+        if (index < 0 || index >= 26 || base[node].children[index] == 0)
+        {
+            return false;  // Word not found
+        }
+        node = base[node].children[index];
+    }
+    return base[node].isEndOfWord;  // True if end of word is reached
+}
+
+// Search for a prefix in the FlatTrie, handling both upper and lowercase input
+bool FlatTrie::startsWith(const string& prefix) const
+{
+    uint32_t node = root();
+    for (char c : prefix)
+    {
+        if (!isalpha(static_cast<unsigned char>(c))) continue;  // Skip non-alphabetic characters
+        int index = toupper(static_cast<unsigned char>(c)) - 'A';
+        if (index < 0 || index >= 26 || base[node].children[index] == 0)
+        {
+            return false;  // Prefix not found
+        }
+        node = base[node].children[index];
+    }
+    return true;  // Prefix is found
+}
+
+// Write the header and the node pool to a compiled dictionary file
+bool FlatTrie::saveCompiled(const string& filename) const
+{
+    ofstream file(filename, ios::binary | ios::trunc);
+    if (!file.is_open())
+    {
+        cerr << "Error: Could not create compiled dictionary file " << filename << endl;
+        return false;
+    }
+
+    const char* pool = reinterpret_cast<const char*>(base);
+    size_t poolSize = count * sizeof(FlatTrieNode);
+
+    CompiledHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, compiledMagic, sizeof(header.magic));
+    header.version = compiledVersion;
+    header.byteOrder = compiledByteOrder;
+    header.nodeSize = sizeof(FlatTrieNode);
+    header.nodeCount = count;
+    header.checksum = poolChecksum(pool, poolSize);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(pool, poolSize);
+    file.close();
+
+    if (!file)
+    {
+        cerr << "Error: Could not write compiled dictionary file " << filename << endl;
+        return false;
+    }
+    return true;
+}
+
+// Map a compiled dictionary and point the trie at the node pool inside it
+bool FlatTrie::loadCompiled(const string& filename)
+{
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        cerr << "Error: Could not open compiled dictionary file " << filename << endl;
+        return false;
+    }
+
+    CompiledHeader header;
+    if (file.size() < sizeof(header))
+    {
+        cerr << "Error: Compiled dictionary file " << filename << " is truncated" << endl;
+        return false;
+    }
+    memcpy(&header, file.data(), sizeof(header));
+
+    if (memcmp(header.magic, compiledMagic, sizeof(header.magic)) != 0)
+    {
+        cerr << "Error: " << filename << " is not a compiled dictionary file" << endl;
+        return false;
+    }
+    if (header.version != compiledVersion || header.byteOrder != compiledByteOrder || header.nodeSize != sizeof(FlatTrieNode))
+    {
+        cerr << "Error: Compiled dictionary file " << filename << " was built by an incompatible version, recompile it" << endl;
+        return false;
+    }
+
+    size_t poolSize = static_cast<size_t>(header.nodeCount) * sizeof(FlatTrieNode);
+    if (header.nodeCount == 0 || header.nodeCount > UINT32_MAX || file.size() - sizeof(header) != poolSize)
+    {
+        cerr << "Error: Compiled dictionary file " << filename << " has the wrong size" << endl;
+        return false;
+    }
+
+    const char* pool = file.data() + sizeof(header);
+    if (poolChecksum(pool, poolSize) != header.checksum)
+    {
+        cerr << "Error: Compiled dictionary file " << filename << " failed its checksum, recompile it" << endl;
+        return false;
+    }
+
+    // The checksum only catches accidents. Searches follow child indices without bounds
+    // checks, so make sure every child is inside the pool and after its parent, as insert
+    // always creates it; that also rules out cycles.
+    const FlatTrieNode* loaded = reinterpret_cast<const FlatTrieNode*>(pool);
+    for (size_t node = 0; node < header.nodeCount; node++)
+    {
+        for (int c = 0; c < 26; c++)
+        {
+            uint32_t child = loaded[node].children[c];
+            if (child != 0 && (child >= header.nodeCount || child <= node))
+            {
+                cerr << "Error: Compiled dictionary file " << filename << " has a bad child index at node " << node << ", recompile it" << endl;
+                return false;
+            }
+        }
+    }
+
+    // Header checks passed, switch the trie over to the mapped pool
+    vector<FlatTrieNode>().swap(nodes);
+    mapped = std::move(file);
+    base = loaded;
+    count = static_cast<size_t>(header.nodeCount);
+    return true;
+}
+
+// Check whether a file starts with the compiled dictionary magic
+bool FlatTrie::isCompiledFile(const string& filename)
+{
+    // Reading the magic from a pipe would consume it before the CSV loader sees it
+    struct stat info;
+    if (stat(filename.c_str(), &info) != 0 || (info.st_mode & S_IFMT) != S_IFREG)
+    {
+        return false;
+    }
+
+    ifstream file(filename, ios::binary);
+    char magic[sizeof(compiledMagic)];
+    if (!file.read(magic, sizeof(magic)))
+    {
+        return false;
+    }
+    return memcmp(magic, compiledMagic, sizeof(magic)) == 0;
+}
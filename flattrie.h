@@ -0,0 +1,112 @@
+/***************************************************************
+# flattrie.h
+# Header for flattrie.cpp, defines the arena-backed FlatTrie class
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of FlatTrie class
+# 2026.10.2    15.10.2026   Compiled dictionary files, saved and memory-mapped
+# 2026.10.3    15.10.2026   Ignore list marked per node in a bitset
+# 2026.10.4    15.10.2026   Added maxWordLength
+# 2026.10.5    16.10.2026   Added countReportable
+# 2026.10.6    16.10.2026   loadCompiled checks every child index
+# 2026.10.7    16.10.2026   reserve copies a mapped pool before growing it
+****************************************************************/
+
+#ifndef FLATTRIE_H
+#define FLATTRIE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+#include "mappedfile.h"
+
+// FlatTrieNode structure, one slot in the FlatTrie node pool.
+// Children are 32-bit indices into the same pool; 0 means "no child",
+// which is safe because index 0 is always the root and is never a child.
+// Nodes hold no pointers, so a pool can be written to disk and mapped back as is.
+struct FlatTrieNode
+{
+    uint32_t children[26];  // Pool indices of child nodes for each alphabet letter
+    bool isEndOfWord;
+};
+
+// FlatTrie class definition.
+// Same insert/search/startsWith behaviour as Trie, but all nodes live in one
+// contiguous vector so lookups stay cache friendly and the whole trie is
+// released in one step instead of a recursive walk.
+// A FlatTrie can also run directly on a memory-mapped compiled dictionary.
+class FlatTrie
+{
+public:
+    FlatTrie();  // Constructor, creates the root node
+
+    FlatTrie(FlatTrie&& other);
+    FlatTrie& operator=(FlatTrie&& other);
+    FlatTrie(const FlatTrie&) = delete;
+    FlatTrie& operator=(const FlatTrie&) = delete;
+
+    void insert(const std::string& word);  // Insert word into FlatTrie
+    bool search(const std::string& word) const;  // Search for complete word in FlatTrie
+    bool startsWith(const std::string& prefix) const;  // Check if prefix exists in FlatTrie
+
+    void clear();  // Release every node at once, leaving an empty root
+    void reserve(size_t nodeCapacity);  // Pre-size the pool to avoid regrowth while loading, copying a mapped pool first
+
+    size_t nodeCount() const { return count; }  // Number of nodes including the root
+    size_t bytes() const;  // Bytes held by the pool, or mapped from a compiled file
+    size_t maxWordLength() const;  // Letters in the longest word, 0 when empty; walks the whole pool
+
+    // Fill counts with the words at or below each node that a search can report: at least
+    // minWordLength letters long and not marked ignored. Searches that stop walking once every
+    // word below a node has been reported start from these counts.
+    void countReportable(int minWordLength, std::vector<uint32_t>& counts) const;
+
+    // Write the node pool to a compiled dictionary file, returns false on I/O failure
+    bool saveCompiled(const std::string& filename) const;
+
+    // Map a compiled dictionary file read-only and search it in place.
+    // Files with the wrong magic, version, layout or checksum, or a child index that is not
+    // inside the pool and after its parent, are rejected.
+    bool loadCompiled(const std::string& filename);
+
+    bool isMapped() const { return mapped.isOpen(); }  // True when running on a compiled file
+
+    // Mark the end-of-word nodes of ignored words, so a search can reject them with a bit test.
+    // Only words spelled entirely with A-Z can equal grid text; anything else is skipped.
+    // Kept beside the pool rather than in it, so mapped dictionaries can be marked too.
+    void markIgnored(const std::set<std::string>& words);
+    void clearIgnored();  // Forget every ignore mark
+
+    // Ignore marks, one bit per node (bit n % 64 of word n / 64); may be shorter than the pool
+    const std::vector<uint64_t>& ignoredBits() const { return ignored; }
+    bool isIgnored(uint32_t node) const
+    {
+        return (node >> 6) < ignored.size() && ((ignored[node >> 6] >> (node & 63)) & 1) != 0;
+    }
+
+    // Check whether a regular file starts with the compiled dictionary magic; a pipe is never read
+    static bool isCompiledFile(const std::string& filename);
+
+    // Node accessors used by GridSearch to walk the trie by index
+    uint32_t root() const { return 0; }
+    uint32_t child(uint32_t node, int index) const { return base[node].children[index]; }
+    bool isEndOfWord(uint32_t node) const { return base[node].isEndOfWord; }
+
+private:
+    uint32_t newNode();  // Append a zeroed node to the pool and return its index
+    void detach();  // Copy a mapped pool into owned memory before it is modified
+
+    std::vector<FlatTrieNode> nodes;  // Owned node pool, nodes[0] is the root
+    const FlatTrieNode* base;  // Nodes being searched, either nodes.data() or the mapped file
+    size_t count;  // Number of nodes at base
+    MappedFile mapped;  // Compiled dictionary mapping, when loaded from file
+    std::vector<uint64_t> ignored;  // Ignore marks, one bit per node
+};
+
+#endif // FLATTRIE_H
@@ -0,0 +1,677 @@
+/***************************************************************
+# fuzzy.cpp
+# Code implementing the FuzzyScanner, words within a Hamming distance along grid lines
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    16.10.2026   Initial implementation of FuzzyScanner class
+# 2026.10.2    16.10.2026   Seed lookups in a grid window index for k = 1 on grids big enough for the dictionary
+# 2026.10.3    16.10.2026   Direction and letter code tables come from directions.h
+****************************************************************/
+
+#include "fuzzy.h"
+#include "directions.h"
+#include <algorithm>
+#include <climits>
+
+using namespace std;
+
+// Marks a node with no occurrence yet
+static const uint32_t noHit = UINT32_MAX;
+
+// Fan-out tables cover the paths of up to fanoutDepth letters. The root is slot 0 and the
+// child c of slot s is slot s * 26 + c + 1, so a walk works out its slot from the letters.
+static const int fanoutDepth = 3;
+static const int fanoutSlots = 1 + 26 + 26 * 26 + 26 * 26 * 26;
+static const int fanoutColumns = 26 + 1 + 26;
+static const uint32_t allChildren = (uint32_t(1) << 26) - 1;
+
+// Number of different seeds of each length, 26 to the power of the length
+static const uint32_t seedCount[FuzzyScanner::maxSeedLength + 1] = {1, 26, 26 * 26, 26 * 26 * 26, 26 * 26 * 26 * 26};
+
+// Words per grid window up to which k = 1 looks words up rather than making the two passes.
+// Past about this many, the lookups of every word cost more than walking every window twice.
+static const size_t seedWordsPerWindow = 16;
+
+// Marks a word with no one-mismatch window yet
+static const size_t noWindow = SIZE_MAX;
+
+const int FuzzyScanner::maxSeedLength;
+const int FuzzyScanner::seedShapes;
+
+// Constructor, lists every word of the trie and collects them backwards into the reversed Dawg
+FuzzyScanner::FuzzyScanner(const FlatTrie& trie)
+    : sourceTrie(&trie), stats(nullptr), line(nullptr), step(0), steps(0), budget(0), earlyBudget(0), minLength(0), row(0), col(0), dir(0), seedLength(0), gridRows(0), gridCols(0)
+{
+    // Depth-first over the forward trie, keeping the letters of the path
+    vector<string> backwards;
+    vector<pair<uint32_t, int>> path;  // Node and next child index to try, per letter
+    string word;
+    path.push_back(make_pair(trie.root(), 0));
+    while (!path.empty())
+    {
+        uint32_t node = path.back().first;
+        int& index = path.back().second;
+        while (index < 26 && trie.child(node, index) == 0)
+        {
+            index++;
+        }
+        if (index == 26)
+        {
+            path.pop_back();
+            if (!word.empty()) word.pop_back();
+            continue;
+        }
+
+        uint32_t child = trie.child(node, index);
+        word += static_cast<char>('A' + index);
+        index++;
+        path.push_back(make_pair(child, 0));
+
+        if (trie.isEndOfWord(child))
+        {
+            backwards.push_back(string(word.rbegin(), word.rend()));
+            FuzzyWord entry = {child, static_cast<uint32_t>(wordLetters.size()), static_cast<int32_t>(word.size())};
+            words.push_back(entry);
+            for (char letter : word)
+            {
+                wordLetters.push_back(static_cast<unsigned char>(letter - 'A'));
+            }
+            if (wordLengths.size() <= word.size()) wordLengths.resize(word.size() + 1, false);
+            wordLengths[word.size()] = true;
+        }
+    }
+    reversed.build(move(backwards));
+
+    buildFanout(trie, forwardFanout);
+    buildFanout(reversed, reverseFanout);
+}
+
+// Depth-first over the top fanoutDepth letters of the trie, filling the row of every node there
+template <typename Index>
+void FuzzyScanner::buildFanout(const Index& trie, vector<uint32_t>& table)
+{
+    table.assign(static_cast<size_t>(fanoutSlots) * fanoutColumns, 0);
+    vector<pair<uint32_t, int>> pending;  // Node and its slot
+    pending.push_back(make_pair(trie.root(), 0));
+    while (!pending.empty())
+    {
+        uint32_t node = pending.back().first;
+        int slot = pending.back().second;
+        pending.pop_back();
+        uint32_t* masks = table.data() + static_cast<size_t>(slot) * fanoutColumns;
+        bool deeper = slot < fanoutSlots / 26;  // Children of this node still have a row
+
+        for (int index = 0; index < 26; index++)
+        {
+            uint32_t child = trie.child(node, index);
+            if (child == 0)
+            {
+                continue;
+            }
+            uint32_t bit = uint32_t(1) << index;
+            if (trie.isEndOfWord(child)) masks[26] |= bit;
+            for (int next = 0; next < 26; next++)
+            {
+                uint32_t grandchild = trie.child(child, next);
+                if (grandchild == 0)
+                {
+                    continue;
+                }
+                masks[next] |= bit;
+                if (trie.isEndOfWord(grandchild)) masks[27 + next] |= bit;
+            }
+            if (deeper) pending.push_back(make_pair(child, slot * 26 + index + 1));
+        }
+    }
+}
+
+// Attach counters to later searches, nullptr turns counting off
+void FuzzyScanner::setStats(SearchStats* searchStats)
+{
+    stats = searchStats;
+}
+
+// Bytes held by the word list, the reversed Dawg and the fan-out tables
+size_t FuzzyScanner::bytes() const
+{
+    return words.capacity() * sizeof(FuzzyWord) + wordLetters.capacity() + reversed.bytes() + (forwardFanout.capacity() + reverseFanout.capacity()) * sizeof(uint32_t);
+}
+
+// Keep the occurrence if the word is new, or this one has fewer mismatches or comes first in grid order
+template <bool CountStats, bool Reverse>
+void FuzzyScanner::record(uint32_t node, int length, int mismatches)
+{
+    if (Reverse && mismatches == 0)
+    {
+        return;  // Exact matches are all found by the forward pass
+    }
+    if (CountStats) counters.hits++;
+    if (length < minLength)
+    {
+        if (CountStats) counters.rejectedMinLength++;
+        return;
+    }
+    if (Reverse)
+    {
+        // The path letters are the word backwards
+        node = sourceTrie->root();
+        for (int k = length; k-- > 0;)
+        {
+            node = sourceTrie->child(node, letters[k]);
+        }
+    }
+    if (sourceTrie->isIgnored(node))
+    {
+        if (CountStats) counters.rejectedIgnored++;
+        return;
+    }
+
+    // The reverse pass read the word from its last letter, so it starts at the far end
+    FuzzyHit hit = {node, row, col, dir, length, mismatches, 0};
+    if (Reverse)
+    {
+        hit.row = row + (length - 1) * gridDx[dir];
+        hit.col = col + (length - 1) * gridDy[dir];
+        hit.dir = (dir + 4) % 8;
+    }
+
+    uint32_t& best = bestHit[node];
+    if (best != noHit)
+    {
+        const FuzzyHit& kept = hits[best];
+        bool better = mismatches != kept.mismatches ? mismatches < kept.mismatches
+                    : (hit.row != kept.row ? hit.row < kept.row : (hit.col != kept.col ? hit.col < kept.col : hit.dir < kept.dir));
+        if (!better)
+        {
+            if (CountStats) counters.rejectedDuplicate++;
+            return;
+        }
+        hits[best].node = 0;  // Superseded by this one
+    }
+
+    hit.textOffset = static_cast<uint32_t>(text.size());
+    for (int k = 0; k < length; k++)
+    {
+        text += static_cast<char>('A' + letters[Reverse ? length - 1 - k : k]);
+    }
+    best = static_cast<uint32_t>(hits.size());
+    hits.push_back(hit);
+    if (CountStats) counters.accepted++;
+}
+
+// Follow the grid letters from node, branching into every other child while mismatches remain
+template <bool CountStats, bool Reverse, typename Index>
+void FuzzyScanner::walk(const Index& trie, uint32_t node, int pos, int mismatches, int early, int cap, int slot)
+{
+    const uint32_t* fanout = Reverse ? reverseFanout.data() : forwardFanout.data();
+    int end = min(steps, cap);
+    for (; pos < end; pos++)
+    {
+        unsigned char code = line[pos * step];
+        if (mismatches < budget)
+        {
+            // The first earlyBudget mismatches may fall anywhere. After that a mismatch here must be
+            // in the second half of the word, which caps it at 2 * pos + 1 letters, or at 2 * pos
+            // when reading backwards, as the backwards first half takes the middle letter.
+            bool isEarly = early < earlyBudget;
+            int branchCap = isEarly ? cap : min(cap, Reverse ? 2 * pos : 2 * pos + 1);
+            if (branchCap > pos && branchCap >= minLength)
+            {
+                // With the last mismatch spent here, the word ends at the child or goes on with
+                // the next grid letter, so near the root only those children are tried
+                uint32_t candidates = allChildren;
+                if (slot >= 0 && mismatches + 1 == budget)
+                {
+                    const uint32_t* masks = fanout + static_cast<size_t>(slot) * fanoutColumns;
+                    unsigned char next = pos + 1 < min(steps, branchCap) ? line[(pos + 1) * step] : 26;
+                    if (next >= 26) candidates = masks[26];
+                    else if (branchCap == pos + 2) candidates = masks[26] | masks[27 + next];
+                    else candidates = masks[26] | masks[next];
+                }
+
+                for (int index = 0; index < 26; index++)
+                {
+                    if (!((candidates >> index) & 1) || index == code)
+                    {
+                        continue;
+                    }
+                    uint32_t child = trie.child(node, index);
+                    if (child == 0)
+                    {
+                        continue;
+                    }
+                    if (CountStats) counters.trieSteps++;
+                    letters[pos] = static_cast<unsigned char>(index);
+                    if (trie.isEndOfWord(child)) record<CountStats, Reverse>(child, pos + 1, mismatches + 1);
+                    int childSlot = slot >= 0 && pos < fanoutDepth ? slot * 26 + index + 1 : -1;
+                    walk<CountStats, Reverse, Index>(trie, child, pos + 1, mismatches + 1, early + (isEarly ? 1 : 0), branchCap, childSlot);
+                }
+            }
+        }
+
+        if (code >= 26 || (node = trie.child(node, code)) == 0)
+        {
+            return;  // Not a letter, or no further path in the trie
+        }
+        if (CountStats) counters.trieSteps++;
+        letters[pos] = code;
+        slot = slot >= 0 && pos < fanoutDepth ? slot * 26 + code + 1 : -1;
+        if (trie.isEndOfWord(node)) record<CountStats, Reverse>(node, pos + 1, mismatches);
+    }
+}
+
+// Walk one trie from every start cell in every direction
+template <bool CountStats, bool Reverse, typename Index>
+void FuzzyScanner::scanGrid(const Index& trie, int rows, int cols)
+{
+    for (row = 0; row < rows; row++)
+    {
+        for (col = 0; col < cols; col++)
+        {
+            for (dir = 0; dir < 8; dir++)
+            {
+                int dirX = gridDx[dir];
+                int dirY = gridDy[dir];
+                int stepsX = dirX < 0 ? row + 1 : (dirX > 0 ? rows - row : INT_MAX);
+                int stepsY = dirY < 0 ? col + 1 : (dirY > 0 ? cols - col : INT_MAX);
+                steps = min(stepsX, stepsY);
+                step = dirX * cols + dirY;
+                line = codes.data() + static_cast<size_t>(row) * cols + col;
+
+                if (CountStats) counters.walksStarted++;
+                walk<CountStats, Reverse, Index>(trie, trie.root(), 0, 0, 0, INT_MAX, 0);
+            }
+        }
+    }
+}
+
+// Pack the first packedLetters letter codes of a window, or of a word, into one word: 5 bits
+// each, first letter lowest, then the window's room (cells to the grid edge, at most 15) on top.
+// A cell past the grid edge packs as offGrid, so it never equals a word letter.
+static const int packedLetters = 12;
+static const int roomShift = 60;
+static const uint64_t offGrid = 27;
+static const uint64_t groupLowBits = 0x0842108421084210ULL >> 4;  // Bit 0 of each 5-bit letter
+
+// Letter bits of the first length packed letters
+static uint64_t packedMask(int length)
+{
+    return length >= packedLetters ? (uint64_t(1) << roomShift) - 1 : (uint64_t(1) << (5 * length)) - 1;
+}
+
+// Pack the first letters of a word, read backwards if reversed
+static uint64_t packWord(const unsigned char* word, int length, bool reversed)
+{
+    uint64_t packed = 0;
+    for (int k = min(length, packedLetters); k-- > 0;)
+    {
+        packed = packed << 5 | word[reversed ? length - 1 - k : k];
+    }
+    return packed;
+}
+
+// Seed shapes: a seed of weight letters, all of the window's first weight letters when gap is 0,
+// or the first weight + 1 letters but the one at gap. Shape weight * (weight - 1) / 2 + gap.
+static int seedShape(int weight, int gap)
+{
+    return weight * (weight - 1) / 2 + gap;
+}
+
+// Seed of a shape from letter codes, read backwards from the last if reversed
+static uint32_t seedKey(const unsigned char* word, int length, int weight, int gap, bool reversed)
+{
+    uint32_t key = 0;
+    for (int k = 0, taken = 0; taken < weight; k++)
+    {
+        if (gap > 0 && k == gap) continue;
+        key = key * 26 + word[reversed ? length - 1 - k : k];
+        taken++;
+    }
+    return key;
+}
+
+// Seeds a word of length letters is looked up by. With one mismatch, a word matches exactly over
+// its first forward letters or its last reverse letters. Where the two overlap, a mismatch there
+// leaves its first forward + 1 letters exact but for that one, so each gap in the overlap is a
+// gapped seed. Words of up to 4 letters take their halves, longer ones the longest seeds indexed.
+void FuzzyScanner::seedPlan(int length, int& forward, int& reverse, int& firstGap, int& lastGap) const
+{
+    if (length <= 4)
+    {
+        forward = min(seedLength, (length + 1) / 2);
+        reverse = min(seedLength, length / 2);
+        firstGap = 1;
+        lastGap = 0;
+        return;
+    }
+    forward = reverse = min(seedLength, length - 1);
+    firstGap = length - forward;
+    lastGap = forward - 1;
+}
+
+// List every window under the seeds of each shape the words of the search need
+void FuzzyScanner::buildSeedIndex(int rows, int cols, uint32_t longestWord)
+{
+    size_t windows = static_cast<size_t>(rows) * cols * 8;
+    gridRows = rows;
+    gridCols = cols;
+
+    // The longest seed that still leaves about one window per seed, so lists stay short
+    // without the index outgrowing the grid
+    seedLength = 1;
+    while (seedLength < maxSeedLength && seedCount[seedLength + 1] <= windows)
+    {
+        seedLength++;
+    }
+
+    for (int d = 0; d < 8; d++)
+    {
+        cellStep[d] = gridDx[d] * cols + gridDy[d];
+    }
+    windowLetters.resize(windows);
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            const unsigned char* cell = codes.data() + static_cast<size_t>(r) * cols + c;
+            for (int d = 0; d < 8; d++)
+            {
+                int stepsX = gridDx[d] < 0 ? r + 1 : (gridDx[d] > 0 ? rows - r : INT_MAX);
+                int stepsY = gridDy[d] < 0 ? c + 1 : (gridDy[d] > 0 ? cols - c : INT_MAX);
+                int room = min(stepsX, stepsY);
+                uint64_t packed = static_cast<uint64_t>(min(room, 15));
+                for (int k = packedLetters; k-- > 0;)
+                {
+                    packed = packed << 5 | (k < room ? cell[k * cellStep[d]] : offGrid);
+                }
+                windowLetters[(static_cast<size_t>(r) * cols + c) * 8 + d] = packed;
+            }
+        }
+    }
+
+    // Only the shapes of word lengths that are in the dictionary and fit the grid
+    bool needed[seedShapes] = {};
+    for (uint32_t length = max(minLength, 1); length <= longestWord && length < wordLengths.size(); length++)
+    {
+        if (!wordLengths[length]) continue;
+        int forward, reverse, firstGap, lastGap;
+        seedPlan(static_cast<int>(length), forward, reverse, firstGap, lastGap);
+        needed[seedShape(forward, 0)] = true;
+        if (reverse > 0) needed[seedShape(reverse, 0)] = true;
+        for (int gap = firstGap; gap <= lastGap; gap++)
+        {
+            needed[seedShape(forward, gap)] = true;
+        }
+    }
+
+    for (int weight = 1; weight <= maxSeedLength; weight++)
+    {
+        for (int gap = 0; gap < weight; gap++)
+        {
+            SeedList& list = seeds[seedShape(weight, gap)];
+            if (!needed[seedShape(weight, gap)])
+            {
+                list.starts.clear();
+                continue;
+            }
+
+            // Count each seed's windows, then place them; windows are visited in index order both times
+            list.starts.assign(seedCount[weight] + 1, 0);
+            for (int pass = 0; pass < 2; pass++)
+            {
+                for (size_t w = 0; w < windows; w++)
+                {
+                    uint64_t packed = windowLetters[w];
+                    uint32_t seed = 0;
+                    int k = 0;
+                    for (int taken = 0; taken < weight; k++)
+                    {
+                        if (gap > 0 && k == gap) continue;
+                        uint32_t code = static_cast<uint32_t>(packed >> (5 * k)) & 31;
+                        if (code >= 26) break;  // No seed holds a cell that is not a letter, or is past the edge
+                        seed = seed * 26 + code;
+                        taken++;
+                    }
+                    if (k < weight + (gap > 0 ? 1 : 0))
+                    {
+                        continue;
+                    }
+                    if (pass == 0)
+                    {
+                        list.starts[seed + 1]++;
+                    }
+                    else
+                    {
+                        uint32_t slot = list.starts[seed]++;
+                        list.windows[slot] = static_cast<uint32_t>(w);
+                        list.letters[slot] = packed;
+                    }
+                }
+
+                if (pass == 0)
+                {
+                    for (size_t seed = 1; seed < list.starts.size(); seed++)
+                    {
+                        list.starts[seed] += list.starts[seed - 1];
+                    }
+                    list.windows.resize(list.starts.back());
+                    list.letters.resize(list.starts.back());
+                }
+                else
+                {
+                    // Placing moved each start to the end of its list, which is where the next list starts
+                    for (size_t seed = list.starts.size() - 1; seed > 0; seed--)
+                    {
+                        list.starts[seed] = list.starts[seed - 1];
+                    }
+                    list.starts[0] = 0;
+                }
+            }
+        }
+    }
+}
+
+// Mismatches between a word and a window, from the packed letters where they cover the word
+int FuzzyScanner::windowMismatches(uint32_t window, uint64_t packed, uint64_t wordPacked, const unsigned char* word, int length, bool reversed) const
+{
+    if (static_cast<int>(packed >> roomShift) < min(length, 15))
+    {
+        return 2;  // Runs off the grid
+    }
+
+    // A letter differs when any of its 5 bits do; fold each letter's bits onto its lowest
+    uint64_t differ = (packed ^ wordPacked) & packedMask(length);
+    differ = (differ | differ >> 1 | differ >> 2 | differ >> 3 | differ >> 4) & groupLowBits;
+    int mismatches = differ == 0 ? 0 : ((differ & (differ - 1)) == 0 ? 1 : 2);
+    if (length <= packedLetters || mismatches == 2)
+    {
+        return mismatches;
+    }
+
+    // Longer words go on along the grid, once the window is known to be long enough
+    int cell = static_cast<int>(window / 8);
+    int d = static_cast<int>(window % 8);
+    int r = cell / gridCols;
+    int c = cell % gridCols;
+    int stepsX = gridDx[d] < 0 ? r + 1 : (gridDx[d] > 0 ? gridRows - r : INT_MAX);
+    int stepsY = gridDy[d] < 0 ? c + 1 : (gridDy[d] > 0 ? gridCols - c : INT_MAX);
+    if (min(stepsX, stepsY) < length)
+    {
+        return 2;
+    }
+    const unsigned char* grid = codes.data() + cell;
+    for (int k = packedLetters; k < length && mismatches < 2; k++)
+    {
+        mismatches += grid[k * cellStep[d]] != word[reversed ? length - 1 - k : k] ? 1 : 0;
+    }
+    return mismatches;
+}
+
+// Look up the first one-mismatch window of every word the exact scan did not find
+template <bool CountStats>
+void FuzzyScanner::seedSearch(int rows, int cols)
+{
+    size_t windows = static_cast<size_t>(rows) * cols * 8;
+    uint32_t longestLine = static_cast<uint32_t>(max(rows, cols));
+
+    for (const FuzzyWord& word : words)
+    {
+        int length = word.length;
+        if (length < minLength || static_cast<uint32_t>(length) > longestLine || bestHit[word.node] != noHit || sourceTrie->isIgnored(word.node))
+        {
+            continue;  // Cannot be reported, or already found exactly
+        }
+        const unsigned char* wordCodes = wordLetters.data() + word.offset;
+        int forward, reverse, firstGap, lastGap;
+        seedPlan(length, forward, reverse, firstGap, lastGap);
+        size_t best = noWindow;
+
+        // Seeds from the word's start: the window starts with the seed. Lists are in window
+        // order, so the first window that matches is the first the seed can find.
+        uint64_t wordPacked = packWord(wordCodes, length, false);
+        for (int gap = 0; gap <= lastGap; gap = gap == 0 ? max(firstGap, 1) : gap + 1)
+        {
+            const SeedList& list = seeds[seedShape(forward, gap)];
+            uint32_t key = seedKey(wordCodes, length, forward, gap, false);
+            for (uint32_t i = list.starts[key], end = list.starts[key + 1]; i < end && list.windows[i] < best; i++)
+            {
+                if (CountStats) counters.walksStarted++;
+                if (windowMismatches(list.windows[i], list.letters[i], wordPacked, wordCodes, length, false) <= 1)
+                {
+                    best = list.windows[i];
+                    break;
+                }
+            }
+        }
+
+        if (reverse == 0)
+        {
+            // A one-letter word differs from every other letter, so its first window is the first one
+            best = 0;
+        }
+        else
+        {
+            // The word's last letters exact: read backwards from its last letter, the window starts
+            // with the reversed word's seed. The word's own start is length - 1 cells back along
+            // the window, at most that many rows and one more cell before it in window order.
+            const SeedList& list = seeds[seedShape(reverse, 0)];
+            uint32_t key = seedKey(wordCodes, length, reverse, 0, true);
+            wordPacked = packWord(wordCodes, length, true);
+            size_t reach = static_cast<size_t>(length - 1) * (cols + 1) * 8 + 8;
+            for (uint32_t i = list.starts[key], end = list.starts[key + 1]; i < end; i++)
+            {
+                uint32_t w = list.windows[i];
+                if (best != noWindow && w >= best + reach)
+                {
+                    break;  // Every later window gives a start after the best one
+                }
+                if (static_cast<int>(list.letters[i] >> roomShift) < min(length, 15))
+                {
+                    continue;  // The word runs off the grid
+                }
+                int d = static_cast<int>(w % 8);
+                size_t start = static_cast<size_t>(static_cast<int>(w / 8) + (length - 1) * cellStep[d]) * 8 + (d + 4) % 8;
+                if (start >= best)
+                {
+                    continue;
+                }
+                if (CountStats) counters.walksStarted++;
+                if (windowMismatches(w, list.letters[i], wordPacked, wordCodes, length, true) <= 1)
+                {
+                    best = start;
+                }
+            }
+        }
+
+        if (best != noWindow && best < windows)
+        {
+            int cell = static_cast<int>(best / 8);
+            row = cell / cols;
+            col = cell % cols;
+            dir = static_cast<int>(best % 8);
+            copy(wordCodes, wordCodes + length, letters.begin());
+            record<CountStats, false>(word.node, length, 1);
+        }
+    }
+}
+
+// Run the passes and lookups, then list the best occurrence of each word in grid order
+vector<string> FuzzyScanner::searchWords(const vector<vector<char>>& grid, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, vector<int>& mismatches, int minWordLength, int maxMismatches)
+{
+    vector<string> result;
+    if (grid.empty())
+    {
+        return result;
+    }
+
+    // Copy the grid into letter codes, never past the shortest row
+    int rows = static_cast<int>(grid.size());
+    int cols = static_cast<int>(grid[0].size());
+    for (const auto& gridRow : grid)
+    {
+        cols = min(cols, static_cast<int>(gridRow.size()));
+    }
+    codes.resize(static_cast<size_t>(rows) * cols);
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            codes[static_cast<size_t>(r) * cols + c] = letterCodes[static_cast<unsigned char>(grid[r][c])];
+        }
+    }
+
+    // One mismatch is an exact pass and seed lookups, unless the dictionary has so many words for
+    // the grid's windows that a forward and a reverse pass are cheaper; more go in one forward pass
+    budget = max(maxMismatches, 0);
+    bool seeded = budget == 1 && words.size() <= static_cast<size_t>(rows) * cols * 8 * seedWordsPerWindow;
+    if (seeded) budget = 0;
+    earlyBudget = budget == 1 ? 0 : budget;
+    bool reversePass = budget == 1;
+    minLength = minWordLength;
+    letters.resize(max(rows, cols));
+    hits.clear();
+    text.clear();
+    bestHit.assign(sourceTrie->nodeCount(), noHit);
+    counters = SearchStats();
+
+    if (seeded) buildSeedIndex(rows, cols, static_cast<uint32_t>(max(rows, cols)));
+    if (stats)
+    {
+        scanGrid<true, false>(*sourceTrie, rows, cols);
+        if (reversePass) scanGrid<true, true>(reversed, rows, cols);
+        if (seeded) seedSearch<true>(rows, cols);
+        stats->add(counters);
+    }
+    else
+    {
+        scanGrid<false, false>(*sourceTrie, rows, cols);
+        if (reversePass) scanGrid<false, true>(reversed, rows, cols);
+        if (seeded) seedSearch<false>(rows, cols);
+    }
+
+    // Hits were kept as found, so put the survivors in grid order
+    hits.erase(remove_if(hits.begin(), hits.end(), [](const FuzzyHit& hit) { return hit.node == 0; }), hits.end());
+    sort(hits.begin(), hits.end(), [this](const FuzzyHit& a, const FuzzyHit& b)
+    {
+        if (a.row != b.row) return a.row < b.row;
+        if (a.col != b.col) return a.col < b.col;
+        if (a.dir != b.dir) return a.dir < b.dir;
+        if (a.length != b.length) return a.length < b.length;
+        return text.compare(a.textOffset, a.length, text, b.textOffset, b.length) < 0;  // Different words over the same cells
+    });
+
+    for (const auto& hit : hits)
+    {
+        string word = text.substr(hit.textOffset, hit.length);
+        int endX = hit.row + (hit.length - 1) * gridDx[hit.dir];
+        int endY = hit.col + (hit.length - 1) * gridDy[hit.dir];
+        result.push_back(word);
+        locations.push_back({word, {{hit.row + 1, hit.col + 1}, {endX + 1, endY + 1}}});
+        mismatches.push_back(hit.mismatches);
+    }
+    return result;
+}
@@ -0,0 +1,197 @@
+/***************************************************************
+# fuzzy.h
+# Header for fuzzy.cpp, defines the approximate FuzzyScanner
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    16.10.2026   Initial implementation of FuzzyScanner class
+# 2026.10.2    16.10.2026   k = 1 looks words up in a grid window index by exact seeds, when the grid is big enough for the dictionary
+# 2026.10.3    16.10.2026   Dropped the letterIndex member for the shared letterCodes table
+****************************************************************/
+
+#ifndef FUZZY_H
+#define FUZZY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "dawg.h"
+#include "flattrie.h"
+#include "searchstats.h"
+
+// FuzzyScanner class definition.
+// Finds dictionary words along grid lines within a Hamming distance: up to k
+// grid letters may differ from the word's letters, as when an OCR'd grid has
+// misread a few cells. A cell that is not a letter differs from every letter.
+// Each (start cell, direction) is walked through the FlatTrie following the
+// grid letters; while mismatches remain, the walk also branches into the
+// node's other children, and a branch stops as soon as its budget is spent
+// and the grid letter has no child.
+//
+// Branching at every letter costs about 50 times an exact search at k = 1, so
+// k = 1 either runs an exact pass and looks up the words it missed, or is
+// split in two passes.
+//
+// Lookups: a word with one mismatch matches exactly over its first letters or
+// its last letters or, where those overlap, over all of the overlap but one
+// letter. Every grid window (start cell and direction) is listed under seeds of
+// its first letters, contiguous or with one gap, so a word's seeds find the
+// windows it may start at, and its last letters reversed find the windows it
+// may end at, read backwards. List entries carry their window's first letters
+// packed in one word, so candidates are checked without touching the grid, and
+// lists are in grid order, so a word's search stops at its first occurrence.
+// A lookup costs a short list walk per word the exact pass did not find, which
+// beats walking every window unless the dictionary has many more words than
+// the grid has windows.
+//
+// Passes, for small grids: a word of length L with one mismatch has it either
+// in its first L / 2 letters or in the rest. The forward pass only branches
+// after the walk is half way through the words it can still report, which caps
+// the word length at about twice the branch depth; the reverse pass does the
+// same over the words spelled backwards, read from their last letter. The
+// backwards words are kept in a minimised Dawg, as their endings are the
+// forward words' shared prefixes; a reverse hit finds its forward node by
+// walking its letters through the FlatTrie.
+// Where the walk is within 3 letters of the root, branches are taken from
+// tables of the children that go on with the next grid letter, or end a word
+// there, so the dense top of the trie is not touched child by child.
+// With k >= 2 the split no longer pays off, since half the mismatches may still
+// fall on the first letters, and a single pass branches anywhere.
+//
+// Each dictionary word is reported once, at its occurrence with the fewest
+// mismatches, the first in (row, col, direction) order among equals. Hits come
+// out in that order, shorter words first at the same start, so with k = 0 the
+// output matches LineScanner. Ignore marks (FlatTrie::markIgnored) and
+// minWordLength filter words as in the other FlatTrie engines.
+class FuzzyScanner
+{
+public:
+    // Longest seed the grid window index is keyed on, and the seed shapes up to that weight
+    static const int maxSeedLength = 4;
+    static const int seedShapes = maxSeedLength * (maxSeedLength + 1) / 2;
+
+    // List the words of a loaded FlatTrie for the lookups, and index them backwards for the reverse pass.
+    // The FlatTrie must outlive the scanner, since the search walks it and reads its ignore marks.
+    explicit FuzzyScanner(const FlatTrie& trie);
+
+    // Search the grid for words within maxMismatches substituted letters. Each word found
+    // comes with its 1-based start and end in locations and its mismatch count in mismatches.
+    std::vector<std::string> searchWords(const std::vector<std::vector<char>>& grid, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, std::vector<int>& mismatches, int minWordLength, int maxMismatches);
+
+    size_t bytes() const;  // Bytes held by the word list, the reversed words and the fan-out tables
+
+    // Count walks, trie steps and hit outcomes of later searches into searchStats.
+    // Pass nullptr (the default) to search without any counting overhead.
+    void setStats(SearchStats* searchStats);
+
+private:
+    // Best occurrence found so far of one word
+    struct FuzzyHit
+    {
+        uint32_t node;  // End-of-word node in the forward trie, 0 once superseded
+        int32_t row;
+        int32_t col;
+        int32_t dir;
+        int32_t length;
+        int32_t mismatches;
+        uint32_t textOffset;  // Word letters in text
+    };
+
+    // One dictionary word, for the lookups
+    struct FuzzyWord
+    {
+        uint32_t node;    // End-of-word node in the forward trie
+        uint32_t offset;  // Letter codes in wordLetters
+        int32_t length;
+    };
+
+    // Windows of the grid listed by their seed of one shape
+    struct SeedList
+    {
+        std::vector<uint32_t> starts;   // Start of each seed's list, empty for a shape not indexed
+        std::vector<uint32_t> windows;  // Windows by seed, in index order within one
+        std::vector<uint64_t> letters;  // Packed letters of the windows listed
+    };
+
+    // Walk on from node, pos cells into the current line. mismatches have been spent, early of
+    // them with no length cap, and words longer than cap letters can no longer be reported.
+    // slot is the node's row in the fan-out table, or -1 deeper than the table goes.
+    template <bool CountStats, bool Reverse, typename Index>
+    void walk(const Index& trie, uint32_t node, int pos, int mismatches, int early, int cap, int slot);
+
+    // Fill a fan-out table for every path of up to fanoutDepth letters in trie
+    template <typename Index>
+    static void buildFanout(const Index& trie, std::vector<uint32_t>& table);
+
+    // Record a word ending at node after length letters, if it beats its best occurrence so far.
+    // A reverse pass node is only an end of word in the Dawg; the word is found from its letters.
+    template <bool CountStats, bool Reverse>
+    void record(uint32_t node, int length, int mismatches);
+
+    // Run one pass over every start cell and direction
+    template <bool CountStats, bool Reverse, typename Index>
+    void scanGrid(const Index& trie, int rows, int cols);
+
+    // Index the grid windows by their first letters, under the seeds words of up to longestWord letters need
+    void buildSeedIndex(int rows, int cols, uint32_t longestWord);
+
+    // Seed weights a word of length letters is looked up by, from its start and from its end,
+    // and the gaps of the gapped seeds it also needs; none when firstGap > lastGap
+    void seedPlan(int length, int& forward, int& reverse, int& firstGap, int& lastGap) const;
+
+    // Find each word the exact pass missed at its first window with one mismatch
+    template <bool CountStats>
+    void seedSearch(int rows, int cols);
+
+    // Mismatches between a word, read backwards if reversed, and the window whose packed first
+    // letters are packed. Stops counting at 2, which also stands for a word running off the grid.
+    int windowMismatches(uint32_t window, uint64_t packed, uint64_t wordPacked, const unsigned char* word, int length, bool reversed) const;
+
+    const FlatTrie* sourceTrie;  // Forward trie, also consulted for ignore marks
+    Dawg reversed;  // Every word spelled backwards
+
+    // Every word of the trie, in trie order, with its letters as codes 0-25
+    std::vector<FuzzyWord> words;
+    std::vector<unsigned char> wordLetters;
+    std::vector<bool> wordLengths;  // Word lengths in the dictionary
+
+    // Fan-out tables of the forward and reversed tries, one row of fanoutColumns masks per path of up
+    // to fanoutDepth letters. Column g < 26 holds the children with a child g, column 26 the children
+    // ending a word, and column 27 + g the children whose child g ends a word; bit c stands for child c.
+    std::vector<uint32_t> forwardFanout;
+    std::vector<uint32_t> reverseFanout;
+
+    SearchStats* stats;  // Counters for the current search, or nullptr
+    SearchStats counters;  // Counters of the search running now
+
+    // The current search and walk
+    std::vector<unsigned char> codes;  // Grid as letter codes, row after row
+    const unsigned char* line;  // First cell of the current walk
+    int step;  // Index step to the next cell of the walk
+    int steps;  // Cells left in the grid along the walk
+    int budget;  // Mismatches allowed
+    int earlyBudget;  // Mismatches allowed before the length cap applies
+    int minLength;
+    int row;  // Start cell and direction of the current walk
+    int col;
+    int dir;
+    std::vector<unsigned char> letters;  // Letters of the trie path being walked
+
+    // Grid window index of the current search. Window w is cell w / 8 read in direction w % 8,
+    // so windows in index order are in (row, col, direction) order.
+    int seedLength;  // Longest seed indexed for this grid
+    int gridRows;
+    int gridCols;
+    int cellStep[8];  // Index step to the next cell in each direction
+    std::vector<uint64_t> windowLetters;  // First letters and room of every window, packed as described in fuzzy.cpp
+    SeedList seeds[seedShapes];  // Per seed shape, see seedShape in fuzzy.cpp
+
+    std::vector<FuzzyHit> hits;  // Best occurrence of each word, replaced ones marked with node 0
+    std::vector<uint32_t> bestHit;  // Index in hits of each forward node's best occurrence, or noHit
+    std::string text;  // Letters of the recorded words
+};
+
+#endif // FUZZY_H
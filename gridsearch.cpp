@@ -4,88 +4,502 @@
 # Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
 # This software is released under the MIT License.
 # See the LICENSE file in the project root for the full license text.
-# Last revised 16/10/2024
+# Last revised 16/10/2026
 #-----------------------------------------------------------------------
 # Version      Date         Notes:
 # 2024.10.1    15.10.2024   Initial implementation of grid search using DFS
 # 2024.10.2    16.10.2024   Fix NaN problem in CSV word loading
 # 2024.10.3    16.10.2024   Remove all spaces from loaded words and ignore list
+# 2026.10.1    15.10.2026   FlatTrie overloads for dfs, searchWords and word loading
+# 2026.10.2    15.10.2026   Optional SearchStats counters, compiled out when unused
+# 2026.10.3    15.10.2026   CSV loading through the memory-mapped CSVReader, BOM and CRLF aware
+# 2026.10.4    15.10.2026   Visited array and found words kept between searches
+# 2026.10.5    15.10.2026   Bigram prefilter skips start cells whose first two letters are no trie path
+# 2026.10.6    15.10.2026   Index-based walk shared by FlatTrie and Dawg, Dawg word loading
+# 2026.10.7    16.10.2026   First-only mode prunes subtrees whose words have all been found
+# 2026.10.8    16.10.2026   Parallel Trie loading, file chunks tokenized concurrently into first-letter shards
+# 2026.10.9    16.10.2026   Character class calls take unsigned char, so bytes above 127 are well defined
+# 2026.10.10   16.10.2026   Trie and FlatTrie searches accept words by per-node bits instead of string sets
+# 2026.10.11   16.10.2026   Direction and letter code tables come from directions.h
 ****************************************************************/
 #include "gridsearch.h"
+#include "csvreader.h"
+#include "directions.h"
+#include "mappedfile.h"
 #include <vector>
 #include <string>
 #include <set>
-#include <fstream>
-#include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <thread>
 
 using namespace std;
 
 // Constructor
-GridSearch::GridSearch() {}
+GridSearch::GridSearch()
+    : stats(nullptr), nodeMarks(false), firstOnly(false), pruneFound(false), countedTrie(nullptr), countedNodes(0),
+      countedIgnore(nullptr), countedIgnoreSize(0), countedMinLength(0) {}
 
 // Destructor
 GridSearch::~GridSearch() {}
 
-// Define the directions for 8 possible moves in the grid (up, down, left, right, and diagonals)
-int dx[] = {-1, -1, -1, 0, 1, 1, 1, 0};
-int dy[] = {-1, 0, 1, 1, 1, 0, -1, -1};
+// Count the end of a walk and classify a hit, in the same order the filters are applied
+static void countWalkEnd(SearchStats* stats, size_t depth)
+{
+    if (depth <= 1)
+    {
+        stats->prunedAtDepthOne++;
+    }
+}
+
+static void countHit(SearchStats* stats, const string& word, const set<string>& foundWords, const set<string>& ignoreWords, int minWordLength)
+{
+    stats->hits++;
+    if (word.length() < static_cast<size_t>(minWordLength))
+    {
+        stats->rejectedMinLength++;
+    }
+    else if (foundWords.find(word) != foundWords.end())
+    {
+        stats->rejectedDuplicate++;
+    }
+    else if (ignoreWords.find(word) != ignoreWords.end())
+    {
+        stats->rejectedIgnored++;
+    }
+    else
+    {
+        stats->accepted++;
+    }
+}
+
+// Bit id of a per-node bitset
+static bool testBit(const vector<uint64_t>& bits, uint32_t id)
+{
+    return ((bits[id >> 6] >> (id & 63)) & 1) != 0;
+}
+
+// Classify a hit from the node bits, in the same order as countHit
+static void countNodeHit(SearchStats* stats, size_t depth, int minWordLength, bool reportable, bool pending)
+{
+    stats->hits++;
+    if (depth < static_cast<size_t>(minWordLength))
+    {
+        stats->rejectedMinLength++;
+    }
+    else if (reportable && !pending)
+    {
+        stats->rejectedDuplicate++;
+    }
+    else if (!reportable)
+    {
+        stats->rejectedIgnored++;
+    }
+    else
+    {
+        stats->accepted++;
+    }
+}
+
+// Attach counters to later searches, nullptr turns counting off
+void GridSearch::setStats(SearchStats* searchStats)
+{
+    stats = searchStats;
+}
 
 // DFS function implementation with location tracking, ignore words, and minimum word length
 void GridSearch::dfs(vector<vector<char>>& grid, vector<vector<bool>>& visited, TrieNode* node, int x, int y, string word, vector<string>& result, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, set<string>& foundWords, const set<string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY)
+{
+    pruneFound = false;  // Direct DFS calls keep their own found set
+    nodeMarks = false;
+    walk<false>(grid, visited, node, x, y, word, result, locations, foundWords, ignoreWords, minWordLength, startX, startY, dirX, dirY);
+}
+
+// DFS body, with the SearchStats counting only compiled into the <true> instantiation
+template <bool CountStats>
+void GridSearch::walk(vector<vector<char>>& grid, vector<vector<bool>>& visited, TrieNode* node, int x, int y, string word, vector<string>& result, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, set<string>& foundWords, const set<string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY)
 {
     if (x < 0 || y < 0 || static_cast<size_t>(x) >= grid.size() || static_cast<size_t>(y) >= grid[0].size() || visited[x][y])
     {
+        if (CountStats) countWalkEnd(stats, word.length());
         return;  // Out of bounds or already visited
     }
 
     char c = grid[x][y];
-    int index = toupper(c) - 'A';  // Ensure the character is uppercase
+    int index = toupper(static_cast<unsigned char>(c)) - 'A';  // Ensure the character is uppercase
 
     // Add index bounds check to ensure valid alphabetic character
     if (index < 0 || index >= 26 || node->children[index] == nullptr)
     {
+        if (CountStats) countWalkEnd(stats, word.length());
         return;  // No further path in the Trie for this character or invalid index
     }
 
     word += c;  // Append the character to the current word
     node = node->children[index];  // Move to the next Trie node
+    if (CountStats) stats->trieSteps++;
 
-    // Check if the word is in ignoreWords and if its length meets the minimum requirement
-    if (node != nullptr && node->isEndOfWord && foundWords.find(word) == foundWords.end() && ignoreWords.find(word) == ignoreWords.end() && word.length() >= static_cast<size_t>(minWordLength))
+    // In first-only mode, stop where every word below has been found already
+    uint32_t id = node->id;
+    if (pruneFound && !keepWalking(id, word.length()))
+    {
+        if (CountStats) stats->exhaustedPrunes++;
+        return;
+    }
+    if (CountStats && node->isEndOfWord)
+    {
+        if (nodeMarks) countNodeHit(stats, word.length(), minWordLength, testBit(reportable, id), testBit(pending, id));
+        else countHit(stats, word, foundWords, ignoreWords, minWordLength);
+    }
+
+    // Only report a word not found already, not in the ignore list and meeting the minimum length.
+    // searchWords has that as one bit per node; direct DFS calls check their own sets.
+    bool fresh = nodeMarks ? (pruneFound ? takeWord(id, word.length()) : takeMark(id))
+                           : node->isEndOfWord && foundWords.find(word) == foundWords.end() && ignoreWords.find(word) == ignoreWords.end() && word.length() >= static_cast<size_t>(minWordLength);
+    if (fresh)
     {
-        // Only add the word if it hasn't been found already, it's not in the ignore list, and it meets the min word length requirement
         result.push_back(word);  // Valid word found
         // Track both the starting and ending positions (1-based indexing)
         locations.push_back({word, {{startX + 1, startY + 1}, {x + 1, y + 1}}});  // Use 1-based coordinates for positions
-        foundWords.insert(word);  // Add the word to the set of found words
+        if (!nodeMarks) foundWords.insert(word);  // Add the word to the set of found words
     }
 
     visited[x][y] = true;  // Mark cell as visited
 
     // Explore the current direction only
-    dfs(grid, visited, node, x + dirX, y + dirY, word, result, locations, foundWords, ignoreWords, minWordLength, startX, startY, dirX, dirY);
+    walk<CountStats>(grid, visited, node, x + dirX, y + dirY, word, result, locations, foundWords, ignoreWords, minWordLength, startX, startY, dirX, dirY);
 
     visited[x][y] = false;  // Backtrack
 }
 
+// Size the visited array for this grid and forget the words found in the last one.
+// Every walk unmarks the cells it visits, so a visited array of the right size is already clear.
+void GridSearch::resetScratch(size_t rows, size_t cols)
+{
+    if (visited.size() != rows || (rows > 0 && visited[0].size() != cols))
+    {
+        visited.assign(rows, vector<bool>(cols, false));
+    }
+    foundWords.clear();
+    pathIds.resize(max(rows, cols) + 1);
+}
+
+// Count every node's reportable words: the end-of-word nodes at least minWordLength letters deep
+// whose word is not in ignoreWords, at or below the node. Explicit stack, as in FlatTrie::maxWordLength.
+template <typename ChildFn, typename EndFn>
+void GridSearch::countWords(size_t nodeCount, ChildFn child, EndFn isEnd, const set<string>& ignoreWords, int minWordLength)
+{
+    counts.assign(nodeCount, 0);
+    reportable.assign((nodeCount + 63) / 64, 0);
+    vector<pair<uint32_t, int>> path;  // Node and next child index to try, per letter
+    string word;
+    path.push_back(make_pair(0u, 0));
+    while (!path.empty())
+    {
+        uint32_t node = path.back().first;
+        int& index = path.back().second;
+        while (index < 26 && child(node, index) == 0)
+        {
+            index++;
+        }
+        if (index == 26)
+        {
+            // Every child is counted, so the node's total goes to its parent
+            path.pop_back();
+            if (!path.empty())
+            {
+                counts[path.back().first] += counts[node];
+                word.pop_back();
+            }
+            continue;
+        }
+
+        uint32_t next = child(node, index);
+        word += static_cast<char>('A' + index);
+        index++;
+        path.push_back(make_pair(next, 0));
+
+        if (isEnd(next) && word.length() >= static_cast<size_t>(minWordLength) && ignoreWords.find(word) == ignoreWords.end())
+        {
+            counts[next] = 1;
+            reportable[next >> 6] |= uint64_t(1) << (next & 63);
+        }
+    }
+}
+
+// Count the pointer Trie's nodes by their id, when this trie was not the last one counted
+void GridSearch::prepareCounts(const Trie& trie, const set<string>& ignoreWords, int minWordLength)
+{
+    pruneFound = firstOnly;
+    nodeMarks = true;
+
+    if (countedTrie != &trie || countedNodes != trie.nodeCount() || countedIgnore != &ignoreWords || countedIgnoreSize != ignoreWords.size() || countedMinLength != minWordLength)
+    {
+        vector<const TrieNode*> byId(trie.nodeCount(), nullptr);
+        vector<const TrieNode*> stack = {trie.root};
+        while (!stack.empty())
+        {
+            const TrieNode* node = stack.back();
+            stack.pop_back();
+            byId[node->id] = node;
+            for (int i = 0; i < 26; i++)
+            {
+                if (node->children[i] != nullptr) stack.push_back(node->children[i]);
+            }
+        }
+
+        countWords(byId.size(),
+                   [&](uint32_t id, int index) -> uint32_t { const TrieNode* next = byId[id]->children[index]; return next ? next->id : 0; },
+                   [&](uint32_t id) { return byId[id]->isEndOfWord; },
+                   ignoreWords, minWordLength);
+        countedTrie = &trie;
+        countedNodes = trie.nodeCount();
+        countedIgnore = &ignoreWords;
+        countedIgnoreSize = ignoreWords.size();
+        countedMinLength = minWordLength;
+    }
+    if (firstOnly) unfound = counts;
+    pending = reportable;
+}
+
+// Count a FlatTrie's nodes by their pool index, when this trie was not the last one counted
+void GridSearch::prepareCounts(const FlatTrie& trie, const set<string>& ignoreWords, int minWordLength)
+{
+    pruneFound = firstOnly;
+    nodeMarks = true;
+
+    if (countedTrie != &trie || countedNodes != trie.nodeCount() || countedIgnore != &ignoreWords || countedIgnoreSize != ignoreWords.size() || countedMinLength != minWordLength)
+    {
+        countWords(trie.nodeCount(),
+                   [&](uint32_t node, int index) { return trie.child(node, index); },
+                   [&](uint32_t node) { return trie.isEndOfWord(node); },
+                   ignoreWords, minWordLength);
+        countedTrie = &trie;
+        countedNodes = trie.nodeCount();
+        countedIgnore = &ignoreWords;
+        countedIgnoreSize = ignoreWords.size();
+        countedMinLength = minWordLength;
+    }
+    if (firstOnly) unfound = counts;
+    pending = reportable;
+}
+
+// Note the node at this depth of the walk, and whether any word at or below it is still to be found
+bool GridSearch::keepWalking(uint32_t id, size_t depth)
+{
+    pathIds[depth - 1] = id;
+    return unfound[id] != 0;
+}
+
+// Report the word at id the first time it is reached
+bool GridSearch::takeMark(uint32_t id)
+{
+    uint64_t mask = uint64_t(1) << (id & 63);
+    if ((pending[id >> 6] & mask) == 0)
+    {
+        return false;  // Not a reportable word, or found already
+    }
+    pending[id >> 6] &= ~mask;
+    return true;
+}
+
+// Same, in first-only mode, also taking the word off the counts of the root and the path
+bool GridSearch::takeWord(uint32_t id, size_t depth)
+{
+    uint64_t mask = uint64_t(1) << (id & 63);
+    if ((pending[id >> 6] & mask) == 0)
+    {
+        return false;  // Not a reportable word, or found already
+    }
+    pending[id >> 6] &= ~mask;
+    unfound[0]--;
+    for (size_t k = 0; k < depth; k++)
+    {
+        unfound[pathIds[k]]--;
+    }
+    return true;
+}
+
+// Size the filter masks for a row of cols cells
+void GridSearch::prepareMasks(size_t cols, uint64_t* masks[8])
+{
+    size_t words = BigramFilter::wordsPerRow(static_cast<int>(cols));
+    filterMasks.resize(8 * words);
+    for (int d = 0; d < 8; d++)
+    {
+        masks[d] = filterMasks.data() + d * words;
+    }
+}
+
 // Main function to search the grid for words in the Trie, with location tracking, ignore words, and minimum word length
 vector<string> GridSearch::searchWords(vector<vector<char>>& grid, Trie* trie, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, const set<string>& ignoreWords, int minWordLength)
 {
     vector<string> result;
-    vector<vector<bool>> visited(grid.size(), vector<bool>(grid[0].size(), false));  // Initialize visited array
-    set<string> foundWords;  // Set to track unique found words
+    resetScratch(grid.size(), grid[0].size());
+    prepareCounts(*trie, ignoreWords, minWordLength);
+
+    // Start DFS from each cell in the grid and explore all 8 directions,
+    // walking only the start cells whose first two letters lead somewhere in the trie
+    uint64_t* masks[8];
+    prepareMasks(grid[0].size(), masks);
+    filter.build(*trie, minWordLength);
 
-    // Start DFS from each cell in the grid and explore all 8 directions
     for (size_t i = 0; i < grid.size(); i++)
     {
+        filter.rowMasks(grid, static_cast<int>(i), static_cast<int>(grid[0].size()), filterCodes, masks);
         for (size_t j = 0; j < grid[0].size(); j++)
         {
+            if (pruneFound && unfound[0] == 0)
+            {
+                return result;  // Every word has been found
+            }
             for (int d = 0; d < 8; d++)    // Explore all 8 directions
             {
-                dfs(grid, visited, trie->root, i, j, "", result, locations, foundWords, ignoreWords, minWordLength, i, j, dx[d], dy[d]);
+                if (((masks[d][j >> 6] >> (j & 63)) & 1) == 0)
+                {
+                    if (stats) stats->walksSkipped++;
+                    continue;  // The walk would end on its first or second cell
+                }
+                if (stats)
+                {
+                    stats->walksStarted++;
+                    walk<true>(grid, visited, trie->root, i, j, "", result, locations, foundWords, ignoreWords, minWordLength, i, j, gridDx[d], gridDy[d]);
+                }
+                else
+                {
+                    walk<false>(grid, visited, trie->root, i, j, "", result, locations, foundWords, ignoreWords, minWordLength, i, j, gridDx[d], gridDy[d]);
+                }
+            }
+        }
+    }
+
+    return result;  // Return all unique found words
+}
+
+// DFS over a FlatTrie, mirroring the TrieNode version step for step
+void GridSearch::dfs(vector<vector<char>>& grid, vector<vector<bool>>& visited, const FlatTrie& trie, uint32_t node, int x, int y, string word, vector<string>& result, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, set<string>& foundWords, const set<string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY)
+{
+    pruneFound = false;  // Direct DFS calls keep their own found set
+    nodeMarks = false;
+    walk<false>(grid, visited, trie, node, x, y, word, result, locations, foundWords, ignoreWords, minWordLength, startX, startY, dirX, dirY);
+}
+
+// DFS over a Dawg, the same walk as over a FlatTrie
+void GridSearch::dfs(vector<vector<char>>& grid, vector<vector<bool>>& visited, const Dawg& trie, uint32_t node, int x, int y, string word, vector<string>& result, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, set<string>& foundWords, const set<string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY)
+{
+    pruneFound = false;  // Direct DFS calls keep their own found set
+    nodeMarks = false;
+    walk<false>(grid, visited, trie, node, x, y, word, result, locations, foundWords, ignoreWords, minWordLength, startX, startY, dirX, dirY);
+}
+
+// FlatTrie and Dawg DFS body, with the SearchStats counting only compiled into the <true> instantiation
+template <bool CountStats, typename IndexTrie>
+void GridSearch::walk(vector<vector<char>>& grid, vector<vector<bool>>& visited, const IndexTrie& trie, uint32_t node, int x, int y, string word, vector<string>& result, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, set<string>& foundWords, const set<string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY)
+{
+    if (x < 0 || y < 0 || static_cast<size_t>(x) >= grid.size() || static_cast<size_t>(y) >= grid[0].size() || visited[x][y])
+    {
+        if (CountStats) countWalkEnd(stats, word.length());
+        return;  // Out of bounds or already visited
+    }
+
+    char c = grid[x][y];
+    int index = toupper(static_cast<unsigned char>(c)) - 'A';  // Ensure the character is uppercase
+
+    // Add index bounds check to ensure valid alphabetic character
+    if (index < 0 || index >= 26 || trie.child(node, index) == 0)
+    {
+        if (CountStats) countWalkEnd(stats, word.length());
+        return;  // No further path in the trie for this character or invalid index
+    }
+
+    word += c;  // Append the character to the current word
+    node = trie.child(node, index);  // Move to the next trie node
+    if (CountStats) stats->trieSteps++;
+
+    // In first-only mode, stop where every word below has been found already
+    if (pruneFound && !keepWalking(node, word.length()))
+    {
+        if (CountStats) stats->exhaustedPrunes++;
+        return;
+    }
+    if (CountStats && trie.isEndOfWord(node))
+    {
+        if (nodeMarks) countNodeHit(stats, word.length(), minWordLength, testBit(reportable, node), testBit(pending, node));
+        else countHit(stats, word, foundWords, ignoreWords, minWordLength);
+    }
+
+    bool fresh = nodeMarks ? (pruneFound ? takeWord(node, word.length()) : takeMark(node))
+                           : trie.isEndOfWord(node) && foundWords.find(word) == foundWords.end() && ignoreWords.find(word) == ignoreWords.end() && word.length() >= static_cast<size_t>(minWordLength);
+    if (fresh)
+    {
+        result.push_back(word);  // Valid word found
+        locations.push_back({word, {{startX + 1, startY + 1}, {x + 1, y + 1}}});  // Use 1-based coordinates for positions
+        if (!nodeMarks) foundWords.insert(word);  // Add the word to the set of found words
+    }
+
+    visited[x][y] = true;  // Mark cell as visited
+
+    // Explore the current direction only
+    walk<CountStats>(grid, visited, trie, node, x + dirX, y + dirY, word, result, locations, foundWords, ignoreWords, minWordLength, startX, startY, dirX, dirY);
+
+    visited[x][y] = false;  // Backtrack
+}
+
+// Search the grid for words in a FlatTrie, same traversal order as the Trie version
+vector<string> GridSearch::searchWords(vector<vector<char>>& grid, const FlatTrie* trie, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, const set<string>& ignoreWords, int minWordLength)
+{
+    prepareCounts(*trie, ignoreWords, minWordLength);
+    return searchIndexed(grid, *trie, locations, ignoreWords, minWordLength);
+}
+
+// Search the grid for words in a Dawg, same traversal order as the Trie version.
+// First-only pruning is left off, as Dawg nodes are shared between words.
+vector<string> GridSearch::searchWords(vector<vector<char>>& grid, const Dawg* trie, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, const set<string>& ignoreWords, int minWordLength)
+{
+    pruneFound = false;
+    nodeMarks = false;
+    return searchIndexed(grid, *trie, locations, ignoreWords, minWordLength);
+}
+
+// Search body over any index-based trie
+template <typename IndexTrie>
+vector<string> GridSearch::searchIndexed(vector<vector<char>>& grid, const IndexTrie& trie, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, const set<string>& ignoreWords, int minWordLength)
+{
+    vector<string> result;
+    resetScratch(grid.size(), grid[0].size());
+
+    // Only walk the start cells whose first two letters lead somewhere in the trie
+    uint64_t* masks[8];
+    prepareMasks(grid[0].size(), masks);
+    filter.build(trie, minWordLength);
+
+    for (size_t i = 0; i < grid.size(); i++)
+    {
+        filter.rowMasks(grid, static_cast<int>(i), static_cast<int>(grid[0].size()), filterCodes, masks);
+        for (size_t j = 0; j < grid[0].size(); j++)
+        {
+            if (pruneFound && unfound[0] == 0)
+            {
+                return result;  // Every word has been found
+            }
+            for (int d = 0; d < 8; d++)    // Explore all 8 directions
+            {
+                if (((masks[d][j >> 6] >> (j & 63)) & 1) == 0)
+                {
+                    if (stats) stats->walksSkipped++;
+                    continue;  // The walk would end on its first or second cell
+                }
+                if (stats)
+                {
+                    stats->walksStarted++;
+                    walk<true>(grid, visited, trie, trie.root(), i, j, "", result, locations, foundWords, ignoreWords, minWordLength, i, j, gridDx[d], gridDy[d]);
+                }
+                else
+                {
+                    walk<false>(grid, visited, trie, trie.root(), i, j, "", result, locations, foundWords, ignoreWords, minWordLength, i, j, gridDx[d], gridDy[d]);
+                }
             }
         }
     }
@@ -108,103 +522,238 @@ string removeAllSpaces(const string& str)
     return result;
 }
 
-// Function to read the grid from a CSV file
-vector<vector<char>> readCSVFile(const string& filename)
+// Copy a field into word without any whitespace, reusing word's buffer
+static void compactField(const char* begin, const char* end, string& word)
+{
+    word.clear();
+    for (const char* c = begin; c != end; c++)
+    {
+        if (!isspace(static_cast<unsigned char>(*c)))
+        {
+            word += *c;
+        }
+    }
+}
+
+// Function to read the grid from a CSV file, one character per non-empty cell
+vector<vector<char>> readCSVFile(const string& filename, size_t* bytesRead)
 {
     vector<vector<char>> grid;
-    ifstream file(filename);
+    CSVReader reader;
 
-    if (!file.is_open())
+    if (!reader.open(filename))
     {
         cerr << "Error: Could not open CSV file " << filename << endl;
         return grid;
     }
 
-    string line;
-    while (getline(file, line))
+    size_t width = 0;
+    while (reader.nextLine())
     {
         vector<char> row;
-        stringstream ss(line);
-        string cell;
-
-        while (getline(ss, cell, ','))
-        {
-            if (!cell.empty())
-            {
-                char upperChar = toupper(cell[0]);  // Convert to uppercase
-                row.push_back(upperChar);  // Assuming each cell contains a single character
-            }
-        }
+        row.reserve(width);  // Rows are almost always as wide as the previous one
+        reader.readCells(row);  // Assuming each cell contains a single character
 
         if (!row.empty())
         {
-            grid.push_back(row);
+            width = row.size();
+            grid.push_back(move(row));
         }
     }
 
-    file.close();
+    if (bytesRead) *bytesRead = reader.size();
     return grid;
 }
 
-// Function to load the words from the CSV file into the Trie, while ignoring NaN values and removing spaces
-void loadWordsFromCSVFile(const string& filename, Trie& trie)
+// Load the words from the CSV file into any trie with an insert(string) member,
+// while ignoring NaN values and removing spaces
+template <typename TrieType>
+static size_t loadWordsIntoTrie(const string& filename, TrieType& trie)
 {
-    ifstream file(filename);
+    CSVReader reader;
 
-    if (!file.is_open())
+    if (!reader.open(filename))
     {
         cerr << "Error: Could not open CSV words file " << filename << endl;
-        return;
+        return 0;
     }
 
-    string line;
-    while (getline(file, line))
+    string word;  // Reused for every field, so loading does not allocate per word
+    const char* begin;
+    const char* end;
+    while (reader.nextLine())
     {
-        stringstream ss(line);
-        string word;
-
-        while (getline(ss, word, ','))
+        while (reader.nextField(begin, end))
         {
             // Remove all spaces from the word
-            word = removeAllSpaces(word);
+            compactField(begin, end, word);
 
-            // Check if the word is not empty, not NaN, and meets minimum length of 3
-            if (!word.empty() && word != "NaN" && word.length() >= 3)
+            // Check if the word is not empty, not NaN, and meets minimum length of 3.
+            // The trie upper cases letters itself as it inserts.
+            if (word.length() >= 3 && word != "NaN")
             {
-                transform(word.begin(), word.end(), word.begin(), ::toupper);
                 trie.insert(word);
             }
         }
     }
 
-    file.close();
+    return reader.size();
+}
+
+// Function to load the words from the CSV file into the Trie
+void loadWordsFromCSVFile(const string& filename, Trie& trie, size_t* bytesRead)
+{
+    size_t bytes = loadWordsIntoTrie(filename, trie);
+    if (bytesRead) *bytesRead = bytes;
+}
+
+// Tokenize the fields of [begin, end), whole lines of a words file, the way loadWordsIntoTrie
+// reads them, and group each accepted word's letters under its first letter
+static void tokenizeChunk(const char* begin, const char* end, TrieChunk& chunk)
+{
+    string word;
+    const char* field = begin;
+    for (const char* c = begin; ; c++)
+    {
+        // A field runs to the next comma or line end; a carriage return is dropped with the other spaces
+        if (c != end && *c != ',' && *c != '\n')
+        {
+            continue;
+        }
+
+        compactField(field, c, word);
+        if (word.length() >= 3 && word != "NaN")
+        {
+            // Keep the letters Trie::insert would walk, upper cased
+            int shard = -1;
+            for (char letter : word)
+            {
+                if (isalpha(static_cast<unsigned char>(letter)))
+                {
+                    char upper = static_cast<char>(toupper(static_cast<unsigned char>(letter)));
+                    if (shard < 0)
+                    {
+                        shard = upper - 'A';
+                    }
+                    chunk.letters[shard].push_back(upper);
+                }
+            }
+            if (shard < 0)
+            {
+                chunk.letterless = true;
+            }
+            else
+            {
+                chunk.ends[shard].push_back(static_cast<uint32_t>(chunk.letters[shard].size()));
+                chunk.positions[shard].push_back(chunk.words++);
+            }
+        }
+
+        if (c == end)
+        {
+            break;
+        }
+        field = c + 1;
+    }
+}
+
+// Function to load the words from the CSV file into the Trie on several threads
+void loadWordsFromCSVFile(const string& filename, Trie& trie, int threads, size_t* bytesRead)
+{
+    if (threads <= 0)
+    {
+        threads = max(1u, thread::hardware_concurrency());  // Use every core
+    }
+
+    MappedFile mapped;
+    if (!mapped.open(filename))
+    {
+        cerr << "Error: Could not open CSV words file " << filename << endl;
+        if (bytesRead) *bytesRead = 0;
+        return;
+    }
+
+    // Split the file after a UTF-8 byte order mark into one chunk per thread, each ending at a line end
+    const char* data = mapped.data();
+    const char* fileEnd = data + mapped.size();
+    if (mapped.size() >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+    {
+        data += 3;
+    }
+    vector<const char*> bounds(1, data);
+    for (int t = 1; t < threads; t++)
+    {
+        const char* cut = data + (fileEnd - data) * t / threads;
+        cut = max(cut, bounds.back());
+        const char* newline = static_cast<const char*>(memchr(cut, '\n', fileEnd - cut));
+        bounds.push_back(newline ? newline + 1 : fileEnd);
+    }
+    bounds.push_back(fileEnd);
+
+    // Tokenize the chunks concurrently, then build the shards from them in file order
+    vector<TrieChunk> chunks(bounds.size() - 1);
+    vector<thread> pool;
+    for (size_t c = 1; c < chunks.size(); c++)
+    {
+        pool.emplace_back(tokenizeChunk, bounds[c], bounds[c + 1], ref(chunks[c]));
+    }
+    tokenizeChunk(bounds[0], bounds[1], chunks[0]);
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+    trie.insertChunks(chunks, threads);
+
+    if (bytesRead) *bytesRead = mapped.size();
+}
+
+// Function to load the words from the CSV file into a FlatTrie
+void loadWordsFromCSVFile(const string& filename, FlatTrie& trie, size_t* bytesRead)
+{
+    size_t bytes = loadWordsIntoTrie(filename, trie);
+    if (bytesRead) *bytesRead = bytes;
+}
+
+// Gathers the words the CSV loader accepts, for dictionaries built from the whole list at once
+struct WordList
+{
+    vector<string> words;
+    void insert(const string& word) { words.push_back(word); }
+};
+
+// Function to load the words from the CSV file and build a Dawg from them
+void loadWordsFromCSVFile(const string& filename, Dawg& dawg, size_t* bytesRead)
+{
+    WordList list;
+    size_t bytes = loadWordsIntoTrie(filename, list);
+    dawg.build(move(list.words));
+    if (bytesRead) *bytesRead = bytes;
 }
 
 // Function to load ignore words from the CSV file into a set, while ignoring NaN values and removing spaces
-set<string> loadIgnoreWordsFromCSV(const string& filename)
+set<string> loadIgnoreWordsFromCSV(const string& filename, size_t* bytesRead)
 {
     set<string> ignoreWords;
-    ifstream file(filename);
+    CSVReader reader;
 
-    if (!file.is_open())
+    if (!reader.open(filename))
     {
         cerr << "Error: Could not open ignore words CSV file " << filename << endl;
         return ignoreWords;
     }
 
-    string line;
-    while (getline(file, line))
+    string word;
+    const char* begin;
+    const char* end;
+    while (reader.nextLine())
     {
-        stringstream ss(line);
-        string word;
-
-        while (getline(ss, word, ','))
+        while (reader.nextField(begin, end))
         {
             // Remove all spaces from the word
-            word = removeAllSpaces(word);
+            compactField(begin, end, word);
 
             // Check if the word is not empty and is alphabetic, and ignore NaN or empty entries
-            if (!word.empty() && word != "NaN" && isalpha(word[0]))
+            if (!word.empty() && word != "NaN" && isalpha(static_cast<unsigned char>(word[0])))
             {
                 transform(word.begin(), word.end(), word.begin(), ::toupper);
                 ignoreWords.insert(word);
@@ -212,6 +761,6 @@ set<string> loadIgnoreWordsFromCSV(const string& filename)
         }
     }
 
-    file.close();
+    if (bytesRead) *bytesRead = reader.size();
     return ignoreWords;
 }
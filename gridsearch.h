@@ -4,21 +4,35 @@
 # Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
 # This software is released under the MIT License.
 # See the LICENSE file in the project root for the full license text.
-# Last revised 16/10/2024
+# Last revised 16/10/2026
 #-----------------------------------------------------------------------
 # Version      Date         Notes:
 # 2024.10.1    15.10.2024   Initial implementation of GridSearch class
 # 2024.10.2    16.10.2024   Fixed issue with NaN entries in word list loading
 # 2024.10.3    16.10.2024   Removed spaces from loaded words and ignore list
+# 2026.10.1    15.10.2026   Added FlatTrie overloads for dfs, searchWords and word loading
+# 2026.10.2    15.10.2026   Added optional SearchStats counters
+# 2026.10.3    15.10.2026   CSV loaders read through CSVReader and report bytes read
+# 2026.10.4    15.10.2026   Search scratch buffers reused between grids
+# 2026.10.5    15.10.2026   Start cells filtered through the BigramFilter before walking
+# 2026.10.6    15.10.2026   Added Dawg overloads for dfs, searchWords and word loading
+# 2026.10.7    16.10.2026   Added first-only mode, pruning subtrees with no unfound word left
+# 2026.10.8    16.10.2026   Added the parallel Trie word loader
+# 2026.10.9    16.10.2026   Trie and FlatTrie searches accept words by per-node bits
 ****************************************************************/
 
 #ifndef GRIDSEARCH_H
 #define GRIDSEARCH_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <set>
 #include "trie.h"
+#include "flattrie.h"
+#include "dawg.h"
+#include "searchstats.h"
+#include "bigramfilter.h"
 
 class GridSearch
 {
@@ -31,22 +45,123 @@ public:
     // tracking valid words and their start and end positions in a 1-based index.
     void dfs(std::vector<std::vector<char>>& grid, std::vector<std::vector<bool>>& visited, TrieNode* node, int x, int y, std::string word, std::vector<std::string>& result, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, std::set<std::string>& foundWords, const std::set<std::string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY);
 
+    // Same DFS walking a FlatTrie, where node is an index into the trie's node pool.
+    void dfs(std::vector<std::vector<char>>& grid, std::vector<std::vector<bool>>& visited, const FlatTrie& trie, uint32_t node, int x, int y, std::string word, std::vector<std::string>& result, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, std::set<std::string>& foundWords, const std::set<std::string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY);
+
+    // Same DFS walking a Dawg, where node is an index into the graph's node array.
+    void dfs(std::vector<std::vector<char>>& grid, std::vector<std::vector<bool>>& visited, const Dawg& trie, uint32_t node, int x, int y, std::string word, std::vector<std::string>& result, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, std::set<std::string>& foundWords, const std::set<std::string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY);
+
     // Search the grid for words in the Trie, respecting ignore words and minimum word length.
     // Stores the locations of found words with their start and end coordinates.
     std::vector<std::string> searchWords(std::vector<std::vector<char>>& grid, Trie* trie, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, const std::set<std::string>& ignoreWords, int minWordLength);
+
+    // Same search over a FlatTrie, producing identical results and ordering.
+    std::vector<std::string> searchWords(std::vector<std::vector<char>>& grid, const FlatTrie* trie, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, const std::set<std::string>& ignoreWords, int minWordLength);
+
+    // Same search over a Dawg, producing identical results and ordering.
+    std::vector<std::string> searchWords(std::vector<std::vector<char>>& grid, const Dawg* trie, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, const std::set<std::string>& ignoreWords, int minWordLength);
+
+    // Count walks, trie steps and hit outcomes of later searches into searchStats.
+    // Pass nullptr (the default) to search without any counting overhead.
+    void setStats(SearchStats* searchStats);
+
+    // First-only mode (off by default) keeps a count of the words not found yet below each
+    // trie node, skips any subtree whose count is zero and stops once every word is found.
+    // Dawg searches ignore the mode, since a Dawg node is shared by many words.
+    //
+    // Trie and FlatTrie searches tell words apart by trie node rather than by grid text, as
+    // the scan engine does, so a word spelled in mixed case is reported once. Whether a node
+    // is reportable (long enough and not ignored) is worked out once per trie, ignore list and
+    // minimum length and kept between searches, so they must not change in place between
+    // searches. Dawg searches and direct dfs calls check the found and ignore sets instead.
+    void setFirstOnly(bool enabled) { firstOnly = enabled; }
+
+private:
+    // DFS bodies behind dfs(); the CountStats = true copies also update stats
+    template <bool CountStats>
+    void walk(std::vector<std::vector<char>>& grid, std::vector<std::vector<bool>>& visited, TrieNode* node, int x, int y, std::string word, std::vector<std::string>& result, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, std::set<std::string>& foundWords, const std::set<std::string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY);
+
+    // IndexTrie is FlatTrie or Dawg, anything with root, child and isEndOfWord over uint32_t nodes
+    template <bool CountStats, typename IndexTrie>
+    void walk(std::vector<std::vector<char>>& grid, std::vector<std::vector<bool>>& visited, const IndexTrie& trie, uint32_t node, int x, int y, std::string word, std::vector<std::string>& result, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, std::set<std::string>& foundWords, const std::set<std::string>& ignoreWords, int minWordLength, int startX, int startY, int dirX, int dirY);
+
+    // searchWords body shared by the FlatTrie and Dawg overloads
+    template <typename IndexTrie>
+    std::vector<std::string> searchIndexed(std::vector<std::vector<char>>& grid, const IndexTrie& trie, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, const std::set<std::string>& ignoreWords, int minWordLength);
+
+    // Prepare the scratch buffers below for a rows x cols grid
+    void resetScratch(size_t rows, size_t cols);
+
+    // Mark the reportable nodes and count the reportable words below each node, unless the
+    // same trie, ignore list and minimum length were counted last time, and start the
+    // search's pending bits, and for a first-only search its unfound counts, from them
+    void prepareCounts(const Trie& trie, const std::set<std::string>& ignoreWords, int minWordLength);
+    void prepareCounts(const FlatTrie& trie, const std::set<std::string>& ignoreWords, int minWordLength);
+
+    // Depth-first count over nodeCount nodes reached from node 0 with child(node, index)
+    template <typename ChildFn, typename EndFn>
+    void countWords(size_t nodeCount, ChildFn child, EndFn isEnd, const std::set<std::string>& ignoreWords, int minWordLength);
+
+    // First-only check of a node reached after depth letters: false when nothing below is left to find
+    bool keepWalking(uint32_t id, size_t depth);
+
+    // Acceptance of the word ending at node id: true the first time a reportable word is reached
+    bool takeMark(uint32_t id);
+
+    // First-only acceptance of the word ending at the node on top of the path; takes it off every count on the path
+    bool takeWord(uint32_t id, size_t depth);
+
+    // Point masks at the 8 direction masks of a row, sized for cols cells
+    void prepareMasks(size_t cols, uint64_t* masks[8]);
+
+    SearchStats* stats;  // Counters for the current search, or nullptr
+    std::vector<std::vector<bool>> visited;  // Cells on the current walk, reused between searches
+    std::set<std::string> foundWords;  // Words reported so far by a search checking sets
+    bool nodeMarks;  // The current search accepts words by the node bits below rather than the sets
+    BigramFilter filter;  // Start cells worth walking, rebuilt for each search's trie
+    std::vector<unsigned char> filterCodes;  // Letter codes scratch for the filter
+    std::vector<uint64_t> filterMasks;  // Candidate masks of the current row, 8 directions back to back
+
+    // Per-node state of Trie and FlatTrie searches, and the first-only state
+    bool firstOnly;  // Mode requested with setFirstOnly
+    bool pruneFound;  // Mode in force for the current search
+    const void* countedTrie;  // Trie, ignore list and minimum length the counts below were made for
+    size_t countedNodes;
+    const std::set<std::string>* countedIgnore;
+    size_t countedIgnoreSize;
+    int countedMinLength;
+    std::vector<uint32_t> counts;  // Reportable words at or below each node
+    std::vector<uint64_t> reportable;  // Nodes ending a reportable word, one bit per node
+    std::vector<uint32_t> unfound;  // counts less the words found in the current search
+    std::vector<uint64_t> pending;  // reportable less the words found in the current search, for every Trie and FlatTrie search
+    std::vector<uint32_t> pathIds;  // Node of each letter of the current walk, by TrieNode id or FlatTrie index
 };
 
 // Function to remove all spaces from a string, returning a new string without any spaces.
 std::string removeAllSpaces(const std::string& str);
 
+// The CSV loaders below read through a memory-mapped CSVReader. A UTF-8 byte order mark
+// and CRLF line endings are handled, and when bytesRead is given it receives the file size.
+
 // Function to read a grid from a CSV file, assuming each cell contains a single character.
-std::vector<std::vector<char>> readCSVFile(const std::string& filename);
+std::vector<std::vector<char>> readCSVFile(const std::string& filename, size_t* bytesRead = nullptr);
 
 // Function to load words from a CSV file into the Trie, ignoring NaN values and removing spaces.
-void loadWordsFromCSVFile(const std::string& filename, Trie& trie);
+void loadWordsFromCSVFile(const std::string& filename, Trie& trie, size_t* bytesRead = nullptr);
+
+// Same loader on threads threads (0 for every core): the file is cut into chunks at line ends,
+// the chunks are tokenized concurrently and the subtries under the root's children are built
+// in parallel by Trie::insertChunks. The Trie is the same as the single-threaded loader's.
+void loadWordsFromCSVFile(const std::string& filename, Trie& trie, int threads, size_t* bytesRead = nullptr);
+
+// Same loader filling a FlatTrie.
+void loadWordsFromCSVFile(const std::string& filename, FlatTrie& trie, size_t* bytesRead = nullptr);
+
+// Same loader building a Dawg from the whole word list once it is read.
+void loadWordsFromCSVFile(const std::string& filename, Dawg& dawg, size_t* bytesRead = nullptr);
 
 // Function to load ignore words from a CSV file into a set, ignoring NaN values and removing spaces.
-std::set<std::string> loadIgnoreWordsFromCSV(const std::string& filename);
+std::set<std::string> loadIgnoreWordsFromCSV(const std::string& filename, size_t* bytesRead = nullptr);
 
 #endif // GRIDSEARCH_H
 
@@ -0,0 +1,213 @@
+/***************************************************************
+# gridstream.cpp
+# Code implementing band-by-band reading and search of grids larger than memory
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of GridBandReader and searchGridStream
+****************************************************************/
+
+#include "gridstream.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using namespace std;
+
+// Constructor, nothing is read until a file is opened
+GridBandReader::GridBandReader()
+    : bandRows(0), takeNext(0), stopping(false), readerMs(0)
+{
+    filled[0] = filled[1] = 0;
+    ready[0] = ready[1] = false;
+}
+
+// Destructor, stops the reader thread even if the caller gave up before the end of the file
+GridBandReader::~GridBandReader()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    changed.notify_all();
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+// Map the grid file and start the reader thread on the first band
+bool GridBandReader::open(const string& filename, size_t rowsPerBand)
+{
+    if (!reader.open(filename))
+    {
+        return false;
+    }
+    bandRows = max(rowsPerBand, static_cast<size_t>(1));
+    worker = thread(&GridBandReader::readLoop, this);
+    return true;
+}
+
+// Fill the two band buffers in turn, each as soon as the caller hands it back.
+// The last band holds no rows, which tells the caller the file has ended.
+void GridBandReader::readLoop()
+{
+    int b = 0;
+    for (;;)
+    {
+        {
+            unique_lock<mutex> guard(lock);
+            changed.wait(guard, [this, b] { return stopping || !ready[b]; });
+            if (stopping)
+            {
+                return;
+            }
+        }
+
+        // The caller does not touch a band until it is marked ready, so it is filled unlocked
+        auto start = chrono::steady_clock::now();
+        vector<vector<char>>& band = bands[b];
+        if (band.size() < bandRows)
+        {
+            band.resize(bandRows);
+        }
+        size_t count = 0;
+        while (count < bandRows && reader.nextLine())
+        {
+            vector<char>& row = band[count];
+            row.clear();  // Keeps the capacity of whichever row this slot held last
+            reader.readCells(row);
+            if (!row.empty())
+            {
+                count++;
+            }
+        }
+        reader.releaseConsumed();  // Rows already parsed need not stay resident
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        {
+            lock_guard<mutex> guard(lock);
+            readerMs += ms;
+            filled[b] = count;
+            ready[b] = true;
+        }
+        changed.notify_all();
+
+        if (count == 0)
+        {
+            return;
+        }
+        b ^= 1;
+    }
+}
+
+// Hand the next band to the caller by swapping row vectors, so no cells are copied
+size_t GridBandReader::nextBand(vector<vector<char>>& rows)
+{
+    int b = takeNext;
+    size_t count;
+    {
+        unique_lock<mutex> guard(lock);
+        changed.wait(guard, [this, b] { return ready[b]; });
+        count = filled[b];
+    }
+
+    // The reader leaves a ready band alone, so the swap needs no lock
+    if (rows.size() < count)
+    {
+        rows.resize(count);
+    }
+    for (size_t k = 0; k < count; k++)
+    {
+        rows[k].swap(bands[b][k]);
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        ready[b] = false;
+    }
+    changed.notify_all();
+    takeNext = b ^ 1;
+    return count;
+}
+
+// Search the grid file a band at a time, keeping only the rows a word can still reach
+StreamSummary searchGridStream(const string& filename, const FlatTrie& trie, LineScanner& scanner, size_t bandRows, int minWordLength, int threads, vector<string>& result, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations)
+{
+    StreamSummary summary = {};
+    summary.bandRows = max(bandRows, static_cast<size_t>(1));
+
+    // A word starting in a band can reach this many rows above or below it
+    size_t longest = trie.maxWordLength();
+    size_t overlap = longest > 0 ? longest - 1 : 0;
+    summary.overlapRows = overlap;
+
+    GridBandReader reader;
+    if (!reader.open(filename, summary.bandRows))
+    {
+        cerr << "Error: Could not open CSV file " << filename << endl;
+        return summary;
+    }
+    summary.opened = true;
+    summary.fileBytes = reader.fileSize();
+
+    vector<vector<char>> window;    // Grid rows [windowStart, windowStart + window.size())
+    vector<vector<char>> incoming;  // Rows of the band just taken from the reader
+    size_t windowStart = 0;
+    size_t searchedTo = 0;          // Start rows before this one have been searched
+    scanner.beginWindows(trie);
+
+    for (;;)
+    {
+        auto waitStart = chrono::steady_clock::now();
+        size_t count = reader.nextBand(incoming);
+        summary.waitMs += chrono::duration<double, milli>(chrono::steady_clock::now() - waitStart).count();
+        bool atEnd = count == 0;
+
+        if (!atEnd)
+        {
+            summary.bands++;
+            if (summary.rows == 0)
+            {
+                summary.cols = incoming[0].size();
+            }
+            summary.rows += count;
+
+            // Drop the rows no unsearched start cell can reach. Their vectors are rotated to
+            // the back and swapped with the new rows, so the reader gets them back to refill.
+            size_t keepFrom = max(windowStart, searchedTo >= overlap ? searchedTo - overlap : 0);
+            size_t drop = keepFrom - windowStart;
+            rotate(window.begin(), window.begin() + drop, window.end());
+            size_t kept = window.size() - drop;
+            window.resize(max(window.size(), kept + count));
+            for (size_t k = 0; k < count; k++)
+            {
+                window[kept + k].swap(incoming[k]);
+            }
+            window.resize(kept + count);
+            windowStart = keepFrom;
+            summary.peakWindowRows = max(summary.peakWindowRows, window.size());
+        }
+
+        // Rows near the bottom of the window wait for the next band, their words may run into it
+        size_t windowEnd = windowStart + window.size();
+        size_t searchEnd = atEnd ? windowEnd : (windowEnd >= overlap ? windowEnd - overlap : 0);
+        if (searchEnd > searchedTo)
+        {
+            scanner.searchWindow(window, trie, static_cast<int>(searchedTo - windowStart), static_cast<int>(searchEnd - windowStart),
+                                 static_cast<int>(windowStart), result, locations, minWordLength, threads);
+            searchedTo = searchEnd;
+        }
+
+        if (atEnd)
+        {
+            break;
+        }
+    }
+
+    summary.readMs = reader.readMs();
+    return summary;
+}
@@ -0,0 +1,91 @@
+/***************************************************************
+# gridstream.h
+# Header for gridstream.cpp, defines the GridBandReader and streamed search
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of GridBandReader and searchGridStream
+****************************************************************/
+
+#ifndef GRIDSTREAM_H
+#define GRIDSTREAM_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "csvreader.h"
+#include "flattrie.h"
+#include "linescan.h"
+
+// GridBandReader class definition.
+// Reads a CSV grid file in bands of rows on a background thread, one band ahead
+// of the caller, so parsing the next band overlaps with searching the current one.
+// Two band buffers are passed back and forth and their row vectors are reused,
+// so once both are full no more memory is allocated whatever the file size.
+class GridBandReader
+{
+public:
+    GridBandReader();
+    ~GridBandReader();  // Stops and joins the reader thread
+
+    GridBandReader(const GridBandReader&) = delete;
+    GridBandReader& operator=(const GridBandReader&) = delete;
+
+    // Open the file and start reading bands of bandRows rows, returns false if it cannot be opened
+    bool open(const std::string& filename, size_t bandRows);
+
+    // Wait for the next band and swap its rows into rows[0..n), growing rows if needed.
+    // The row vectors previously in those slots go back to the reader to be refilled.
+    // Returns the number of rows, 0 at the end of the file.
+    size_t nextBand(std::vector<std::vector<char>>& rows);
+
+    size_t fileSize() const { return reader.size(); }
+    double readMs() const { return readerMs; }  // Time the reader thread spent parsing, valid once every band is taken
+
+private:
+    void readLoop();  // Reader thread body
+
+    CSVReader reader;
+    size_t bandRows;
+    std::thread worker;
+
+    std::mutex lock;                         // Guards everything below
+    std::condition_variable changed;         // Signalled when a band is filled or handed back
+    std::vector<std::vector<char>> bands[2]; // Band buffers, filled by the reader in turn
+    size_t filled[2];                        // Rows in each band buffer, 0 when empty
+    bool ready[2];                           // True while a band waits to be taken
+    int takeNext;                            // Band buffer the caller takes next
+    bool stopping;                           // Destructor asked the reader to stop
+    double readerMs;                         // Parsing time of the reader thread
+};
+
+// Summary of a streamed search, for --stats
+struct StreamSummary
+{
+    bool opened;             // False if the grid file could not be read
+    size_t rows;             // Grid rows read
+    size_t cols;             // Width of the first row
+    size_t bands;            // Bands read
+    size_t bandRows;         // Rows per band
+    size_t overlapRows;      // Rows of context kept above and below each band
+    size_t peakWindowRows;   // Most rows held in the search window at once
+    size_t fileBytes;        // Size of the grid file
+    double readMs;           // Time spent parsing on the reader thread
+    double waitMs;           // Time the search waited for the reader
+};
+
+// Search a grid file band by band with the scan engine, never holding more than one
+// band plus 2 * (longest word - 1) rows of context, with the next band read meanwhile.
+// Each band owns the words that start in it; the rows of context above and below
+// let a word reach out of its band, so every word is found exactly once and the
+// results match LineScanner::searchWords on the whole grid.
+StreamSummary searchGridStream(const std::string& filename, const FlatTrie& trie, LineScanner& scanner, size_t bandRows, int minWordLength, int threads, std::vector<std::string>& result, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations);
+
+#endif // GRIDSTREAM_H
@@ -0,0 +1,420 @@
+/***************************************************************
+# linescan.cpp
+# Code implementing an allocation-free straight-line grid scanner
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of LineScanner class
+# 2026.10.2    15.10.2026   Parallel search over row bands with deterministic merge
+# 2026.10.3    15.10.2026   Optional SearchStats counters, compiled out when unused
+# 2026.10.4    15.10.2026   Ignore and already-reported checks are per-node bit tests
+# 2026.10.5    15.10.2026   All-occurrences search into compact WordHit records
+# 2026.10.6    15.10.2026   Windowed search for grids streamed in row windows
+# 2026.10.7    15.10.2026   Bigram prefilter skips start cells whose first two letters are no trie path
+# 2026.10.8    16.10.2026   First-only mode stops walks where every word below has been reported
+# 2026.10.9    16.10.2026   Band count worked out in long long, so a huge thread count cannot overflow it
+# 2026.10.10   16.10.2026   Direction and letter code tables come from directions.h
+****************************************************************/
+
+#include "linescan.h"
+#include "directions.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+
+using namespace std;
+
+// Constructor
+LineScanner::LineScanner()
+    : stats(nullptr), firstOnly(false), countedTrie(nullptr), countedNodes(0), countedMinLength(0) {}
+
+// Attach counters to later searches, nullptr turns counting off
+void LineScanner::setStats(SearchStats* searchStats)
+{
+    stats = searchStats;
+}
+
+// Reset a reported bitset to the trie's ignore marks, so ignored words look already reported
+void LineScanner::resetReported(const FlatTrie& trie, vector<uint64_t>& reported)
+{
+    const vector<uint64_t>& ignored = trie.ignoredBits();
+    reported.assign((trie.nodeCount() + 63) / 64, 0);
+    copy(ignored.begin(), ignored.begin() + min(ignored.size(), reported.size()), reported.begin());
+}
+
+// Count the reportable words below each node, unless this trie and minimum length were counted last time
+void LineScanner::prepareCounts(const FlatTrie& trie, int minWordLength)
+{
+    if (countedTrie == &trie && countedNodes == trie.nodeCount() && countedMinLength == minWordLength)
+    {
+        return;
+    }
+    trie.countReportable(minWordLength, counts);
+    countedTrie = &trie;
+    countedNodes = trie.nodeCount();
+    countedMinLength = minWordLength;
+}
+
+// Rebuild the word text of a hit from the grid and append it with its 1-based start and end
+void LineScanner::appendHit(const vector<vector<char>>& grid, const ScanHit& hit, int rowOffset, vector<string>& result, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations)
+{
+    int dirX = gridDx[hit.dir];
+    int dirY = gridDy[hit.dir];
+    string word;
+    word.reserve(hit.length);
+    for (int k = 0; k < hit.length; k++)
+    {
+        word += grid[hit.row + k * dirX][hit.col + k * dirY];
+    }
+
+    int endX = hit.row + (hit.length - 1) * dirX;
+    int endY = hit.col + (hit.length - 1) * dirY;
+    result.push_back(word);
+    locations.push_back({word, {{rowOffset + hit.row + 1, hit.col + 1}, {rowOffset + endX + 1, endY + 1}}});  // Use 1-based coordinates for positions
+}
+
+// Walk every start cell in rows [rowBegin, rowEnd) and all 8 directions as straight lines through the FlatTrie.
+// The CountStats = true copy also fills band.stats; the false copy has no counting at all.
+// The AllHits = true copy keeps every occurrence in band.all instead of first ones in band.hits.
+template <bool CountStats, bool AllHits>
+void LineScanner::scanRows(const vector<vector<char>>& grid, int cols, const FlatTrie& trie, int minWordLength, int rowBegin, int rowEnd, vector<uint64_t>& reported, uint32_t* remaining, BandResult& band) const
+{
+    int rows = static_cast<int>(grid.size());
+    uint64_t* reportedBits = reported.data();
+
+    // Candidate masks of the current row, one array per direction
+    size_t maskWords = BigramFilter::wordsPerRow(cols);
+    vector<uint64_t> maskBuffer(8 * maskWords);
+    vector<unsigned char> codes;
+    uint64_t* masks[8];
+    for (int d = 0; d < 8; d++)
+    {
+        masks[d] = maskBuffer.data() + d * maskWords;
+    }
+
+    for (int i = rowBegin; i < rowEnd; i++)
+    {
+        if (remaining && remaining[0] == 0)
+        {
+            return;  // This thread has reported every word
+        }
+        filter.rowMasks(grid, i, cols, codes, masks);
+        if (CountStats) band.stats.walksSkipped += 8 * static_cast<uint64_t>(cols);  // Walks started are taken back off below
+
+        for (int j = 0; j < cols; j++)
+        {
+            // Runs of 64 cells with no candidate in any direction are passed over a word at a time
+            size_t w = static_cast<size_t>(j) >> 6;
+            uint64_t any = masks[0][w] | masks[1][w] | masks[2][w] | masks[3][w] | masks[4][w] | masks[5][w] | masks[6][w] | masks[7][w];
+            if (((any >> (j & 63)) & 1) == 0)
+            {
+                if (any >> (j & 63) == 0)
+                {
+                    j |= 63;  // Nothing left in this word, move on to the next one
+                }
+                continue;
+            }
+
+            for (int d = 0; d < 8; d++)    // Explore all 8 directions
+            {
+                if (((masks[d][w] >> (j & 63)) & 1) == 0)
+                {
+                    continue;  // The walk would end on its first or second cell
+                }
+
+                int dirX = gridDx[d];
+                int dirY = gridDy[d];
+
+                // Number of cells available in this direction, so the loop needs no bounds checks.
+                // A zero step never runs off the grid on that axis, so only the other one limits it.
+                int stepsX = dirX < 0 ? i + 1 : (dirX > 0 ? rows - i : INT_MAX);
+                int stepsY = dirY < 0 ? j + 1 : (dirY > 0 ? cols - j : INT_MAX);
+                int steps = min(stepsX, stepsY);
+                if (AllHits) steps = min(steps, static_cast<int>(UINT16_MAX));  // WordHit::length is 16 bits
+
+                uint32_t node = trie.root();
+                int x = i;
+                int y = j;
+                int matched = 0;  // Letters matched so far, only read when counting
+                if (CountStats)
+                {
+                    band.stats.walksStarted++;
+                    band.stats.walksSkipped--;
+                }
+
+                for (int len = 1; len <= steps; len++, x += dirX, y += dirY)
+                {
+                    unsigned char index = letterCodes[static_cast<unsigned char>(grid[x][y])];
+                    if (index >= 26)
+                    {
+                        break;  // Not a letter, no word can continue through this cell
+                    }
+
+                    node = trie.child(node, index);
+                    if (node == 0)
+                    {
+                        break;  // No further path in the FlatTrie
+                    }
+                    if (remaining && remaining[node] == 0)
+                    {
+                        if (CountStats) band.stats.exhaustedPrunes++;
+                        break;  // Every word from here on has been reported
+                    }
+                    if (CountStats)
+                    {
+                        band.stats.trieSteps++;
+                        matched = len;
+                    }
+
+                    if (trie.isEndOfWord(node))
+                    {
+                        if (CountStats) band.stats.hits++;
+                        if (len < minWordLength)
+                        {
+                            if (CountStats) band.stats.rejectedMinLength++;
+                            continue;
+                        }
+
+                        // One bit test covers both "already reported" and "ignored"
+                        uint64_t mask = uint64_t(1) << (node & 63);
+                        uint64_t& bits = reportedBits[node >> 6];
+                        if (bits & mask)
+                        {
+                            if (CountStats)
+                            {
+                                if (AllHits || trie.isIgnored(node)) band.stats.rejectedIgnored++;
+                                else band.stats.rejectedDuplicate++;
+                            }
+                            continue;
+                        }
+
+                        if (AllHits)
+                        {
+                            // The node stands in for the word id until the merge interns it
+                            band.all.push_back({node, i, j, static_cast<uint16_t>(d), static_cast<uint16_t>(len)});
+                        }
+                        else
+                        {
+                            bits |= mask;
+                            band.hits.push_back({node, i, j, d, len});
+                            if (remaining)
+                            {
+                                // Take the word off the counts of the root and every node on its path
+                                remaining[0]--;
+                                uint32_t step = trie.root();
+                                for (int k = 0; k < len; k++)
+                                {
+                                    step = trie.child(step, letterCodes[static_cast<unsigned char>(grid[i + k * dirX][j + k * dirY])]);
+                                    remaining[step]--;
+                                }
+                            }
+                        }
+                        if (CountStats) band.stats.accepted++;
+                    }
+                }
+
+                if (CountStats && matched <= 1) band.stats.prunedAtDepthOne++;
+            }
+        }
+    }
+}
+
+// Run scanRows with or without counters and in the requested reporting mode
+void LineScanner::scanBand(const vector<vector<char>>& grid, int cols, const FlatTrie& trie, int minWordLength, int rowBegin, int rowEnd, vector<uint64_t>& reported, uint32_t* remaining, BandResult& band, bool allHits) const
+{
+    band.hits.clear();
+    band.all.clear();
+    band.stats = SearchStats();
+
+    if (allHits)
+    {
+        if (stats) scanRows<true, true>(grid, cols, trie, minWordLength, rowBegin, rowEnd, reported, remaining, band);
+        else scanRows<false, true>(grid, cols, trie, minWordLength, rowBegin, rowEnd, reported, remaining, band);
+    }
+    else
+    {
+        if (stats) scanRows<true, false>(grid, cols, trie, minWordLength, rowBegin, rowEnd, reported, remaining, band);
+        else scanRows<false, false>(grid, cols, trie, minWordLength, rowBegin, rowEnd, reported, remaining, band);
+    }
+}
+
+// Scan start rows [rowBegin, rowEnd) into bands, splitting them into row bands when more than one thread is requested
+void LineScanner::runBands(const vector<vector<char>>& grid, int cols, const FlatTrie& trie, int minWordLength, int threads, bool allHits, int rowBegin, int rowEnd, const vector<uint64_t>* seed)
+{
+    int rows = rowEnd - rowBegin;
+    filter.build(trie, minWordLength);
+
+    // First-only counts start from the trie for each whole-grid searchWords
+    bool prune = firstOnly && !allHits && seed == nullptr;
+    if (prune) prepareCounts(trie, minWordLength);
+
+    if (threads <= 1 || rows < 2)
+    {
+        bands.resize(1);
+        if (seed) reported = *seed;
+        else resetReported(trie, reported);
+        if (prune) remaining = counts;
+        scanBand(grid, cols, trie, minWordLength, rowBegin, rowEnd, reported, prune ? remaining.data() : nullptr, bands[0], allHits);
+        return;
+    }
+
+    // Several bands per thread so a band full of hits does not leave the other threads idle
+    int bandCount = static_cast<int>(min<long long>(rows, static_cast<long long>(threads) * 8));
+    int workers = min(threads, bandCount);
+    bands.resize(bandCount);
+    vector<vector<uint64_t>> workerReported(workers);
+    vector<vector<uint32_t>> workerRemaining(prune ? workers : 0);
+    atomic<int> nextBand(0);
+
+    // Each worker keeps one reported bitset, and its own counts, across its bands. Workers claim
+    // bands in increasing order, so a word it suppresses always has an earlier kept occurrence.
+    auto worker = [&](int w)
+    {
+        if (seed) workerReported[w] = *seed;
+        else resetReported(trie, workerReported[w]);
+        if (prune) workerRemaining[w] = counts;
+        for (int b = nextBand++; b < bandCount; b = nextBand++)
+        {
+            int bandBegin = rowBegin + static_cast<int>(static_cast<long long>(rows) * b / bandCount);
+            int bandEnd = rowBegin + static_cast<int>(static_cast<long long>(rows) * (b + 1) / bandCount);
+            scanBand(grid, cols, trie, minWordLength, bandBegin, bandEnd, workerReported[w], prune ? workerRemaining[w].data() : nullptr, bands[b], allHits);
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < workers; t++)
+    {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);  // The calling thread takes a share of the bands too
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+}
+
+// Width of the grid, never stepping past the shortest row
+static int gridWidth(const vector<vector<char>>& grid)
+{
+    size_t width = grid[0].size();
+    for (const auto& row : grid)
+    {
+        width = min(width, row.size());
+    }
+    return static_cast<int>(width);
+}
+
+// Search the grid, splitting it into row bands when more than one thread is requested
+vector<string> LineScanner::searchWords(const vector<vector<char>>& grid, const FlatTrie& trie, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, int minWordLength, int threads)
+{
+    vector<string> result;
+
+    if (grid.empty())
+    {
+        return result;
+    }
+
+    runBands(grid, gridWidth(grid), trie, minWordLength, threads, false, 0, static_cast<int>(grid.size()), nullptr);
+
+    reported.assign((trie.nodeCount() + 63) / 64, 0);
+    mergeHits(grid, 0, reported, result, locations);
+
+    return result;  // Return all unique found words
+}
+
+// Merge in row order; a word seen in an earlier band wins, exactly as in the sequential scan
+void LineScanner::mergeHits(const vector<vector<char>>& grid, int rowOffset, vector<uint64_t>& merged, vector<string>& result, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations)
+{
+    for (auto& bandResult : bands)
+    {
+        for (const auto& hit : bandResult.hits)
+        {
+            uint64_t mask = uint64_t(1) << (hit.node & 63);
+            if ((merged[hit.node >> 6] & mask) == 0)
+            {
+                merged[hit.node >> 6] |= mask;
+                appendHit(grid, hit, rowOffset, result, locations);
+            }
+            else if (stats)
+            {
+                bandResult.stats.accepted--;  // Reported by an earlier band, so a duplicate overall
+                bandResult.stats.rejectedDuplicate++;
+            }
+        }
+        if (stats) stats->add(bandResult.stats);
+    }
+}
+
+// Start a windowed search with nothing reported yet
+void LineScanner::beginWindows(const FlatTrie& trie)
+{
+    resetReported(trie, windowReported);
+}
+
+// Search the start rows [rowBegin, rowEnd) of one window of a streamed grid
+void LineScanner::searchWindow(const vector<vector<char>>& window, const FlatTrie& trie, int rowBegin, int rowEnd, int rowOffset, vector<string>& result, vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, int minWordLength, int threads)
+{
+    if (window.empty() || rowBegin >= rowEnd)
+    {
+        return;
+    }
+
+    // Scans start from the words already reported, so earlier windows' words are not even collected
+    runBands(window, gridWidth(window), trie, minWordLength, threads, false, rowBegin, rowEnd, &windowReported);
+    mergeHits(window, rowOffset, windowReported, result, locations);
+}
+
+// Intern the word of each hit in a band, then move the hits into the results
+void LineScanner::appendAll(const vector<vector<char>>& grid, BandResult& band, SearchResults& results)
+{
+    string word;
+    for (auto& hit : band.all)
+    {
+        uint32_t id = results.words.find(hit.wordId);
+        if (id == WordTable::npos)
+        {
+            // First time this word is seen, copy its letters out of the grid once
+            word.clear();
+            for (int k = 0; k < hit.length; k++)
+            {
+                word += grid[hit.row + k * gridDx[hit.dir]][hit.col + k * gridDy[hit.dir]];
+            }
+            id = results.words.add(hit.wordId, word.data(), word.size());
+        }
+        hit.wordId = id;
+    }
+
+    if (results.hits.empty())
+    {
+        results.hits.swap(band.all);  // Single band: hand the buffer over without copying
+    }
+    else
+    {
+        results.hits.insert(results.hits.end(), band.all.begin(), band.all.end());
+    }
+}
+
+// Search the grid for every occurrence of every word, in the same order as searchWords
+void LineScanner::searchAll(const vector<vector<char>>& grid, const FlatTrie& trie, SearchResults& results, int minWordLength, int threads)
+{
+    results.hits.clear();
+    results.words.reset(trie.nodeCount());
+
+    if (grid.empty())
+    {
+        return;
+    }
+
+    runBands(grid, gridWidth(grid), trie, minWordLength, threads, true, 0, static_cast<int>(grid.size()), nullptr);
+
+    // Bands are already in row order, so appending them in turn keeps the hits sorted
+    for (auto& bandResult : bands)
+    {
+        appendAll(grid, bandResult, results);
+        if (stats) stats->add(bandResult.stats);
+    }
+}
@@ -0,0 +1,138 @@
+/***************************************************************
+# linescan.h
+# Header for linescan.cpp, defines the iterative straight-line LineScanner
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of LineScanner class
+# 2026.10.2    15.10.2026   Parallel search over row bands with deterministic merge
+# 2026.10.3    15.10.2026   Added optional SearchStats counters
+# 2026.10.4    15.10.2026   Ignore and already-reported checks are per-node bit tests
+# 2026.10.5    15.10.2026   Added searchAll, every occurrence as compact WordHit records
+# 2026.10.6    15.10.2026   Added beginWindows and searchWindow for grids streamed in row windows
+# 2026.10.7    15.10.2026   Start cells filtered through the BigramFilter before walking
+# 2026.10.8    16.10.2026   Added first-only mode for searchWords
+# 2026.10.9    16.10.2026   Dropped the letterIndex member for the shared letterCodes table
+****************************************************************/
+
+#ifndef LINESCAN_H
+#define LINESCAN_H
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include "flattrie.h"
+#include "searchstats.h"
+#include "wordtable.h"
+#include "bigramfilter.h"
+
+// LineScanner class definition.
+// Straight-line replacement for GridSearch::dfs. Every (start cell, direction)
+// pair is walked with a plain loop that only tracks the current FlatTrie node
+// and the walk length; the word text is rebuilt from the grid only on a hit.
+// Ignore words are taken from the trie's ignore marks (FlatTrie::markIgnored),
+// and words already reported are tracked in a bitset indexed by node.
+// A BigramFilter marks the (start cell, direction) pairs whose first two
+// letters are a trie path, and only those are walked.
+class LineScanner
+{
+public:
+    LineScanner();
+
+    // Search the grid for words in the FlatTrie, skipping words marked ignored and words
+    // shorter than minWordLength. Produces the same words, locations and ordering as
+    // GridSearch::searchWords given the same ignore list.
+    // With threads > 1 the grid is split into row bands searched concurrently; the
+    // bands are merged in row order so the output does not depend on the thread count.
+    std::vector<std::string> searchWords(const std::vector<std::vector<char>>& grid, const FlatTrie& trie, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, int minWordLength, int threads = 1);
+
+    // Search the grid for every occurrence of every word, not just the first one.
+    // Hits are written to results as WordHit records in (row, col, direction, length)
+    // order; each distinct word is stored once in results.words. Ignore marks and
+    // minWordLength filter hits as in searchWords. Words longer than 65535 letters are not reported.
+    void searchAll(const std::vector<std::vector<char>>& grid, const FlatTrie& trie, SearchResults& results, int minWordLength, int threads = 1);
+
+    // Search a grid too large to hold at once, as consecutive windows of rows.
+    // beginWindows forgets the words reported so far. searchWindow then searches the start
+    // cells in window rows [rowBegin, rowEnd); the window must hold every row a word starting
+    // there can reach. Reported rows are shifted by rowOffset, the grid row of window[0].
+    // Words reported by an earlier window are skipped, so windows searched in row order
+    // give the same words, locations and ordering as searchWords on the whole grid.
+    void beginWindows(const FlatTrie& trie);
+    void searchWindow(const std::vector<std::vector<char>>& window, const FlatTrie& trie, int rowBegin, int rowEnd, int rowOffset, std::vector<std::string>& result, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, int minWordLength, int threads = 1);
+
+    // Count walks, trie steps and hit outcomes of later searches into searchStats.
+    // Pass nullptr (the default) to search without any counting overhead.
+    void setStats(SearchStats* searchStats);
+
+    // First-only mode (off by default) makes searchWords keep a count of the words not reported
+    // yet below each trie node, stop a walk at a node whose count is zero and stop a thread once
+    // it has reported every word. The output does not change. The counts are kept between
+    // searches, so the trie and its ignore marks must not change while the mode is on.
+    void setFirstOnly(bool enabled) { firstOnly = enabled; }
+
+private:
+    // One reported word: its end-of-word node, start cell, direction index and length
+    struct ScanHit
+    {
+        uint32_t node;
+        int32_t row;
+        int32_t col;
+        int32_t dir;
+        int32_t length;
+    };
+
+    // Results of one row band, kept apart until the final merge
+    struct BandResult
+    {
+        std::vector<ScanHit> hits;  // First occurrence of each word seen by the band's thread
+        std::vector<WordHit> all;   // Every occurrence, wordId holding the node until interned
+        SearchStats stats;  // Counters for this band, only filled when stats are attached
+    };
+
+    // Scan every start cell in rows [rowBegin, rowEnd) into band, with or without counters.
+    // reported holds one bit per node, set for words already reported or ignored.
+    // With allHits every occurrence goes to band.all and reported only holds the ignore marks.
+    // remaining, when not null, holds the words below each node not yet reported by this thread.
+    void scanBand(const std::vector<std::vector<char>>& grid, int cols, const FlatTrie& trie, int minWordLength, int rowBegin, int rowEnd, std::vector<uint64_t>& reported, uint32_t* remaining, BandResult& band, bool allHits) const;
+
+    template <bool CountStats, bool AllHits>
+    void scanRows(const std::vector<std::vector<char>>& grid, int cols, const FlatTrie& trie, int minWordLength, int rowBegin, int rowEnd, std::vector<uint64_t>& reported, uint32_t* remaining, BandResult& band) const;
+
+    // Rebuild the word text of a hit and append it to the results, its row shifted by rowOffset
+    static void appendHit(const std::vector<std::vector<char>>& grid, const ScanHit& hit, int rowOffset, std::vector<std::string>& result, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations);
+
+    // Append the band hits in band order, skipping words whose bit is already set in merged
+    void mergeHits(const std::vector<std::vector<char>>& grid, int rowOffset, std::vector<uint64_t>& merged, std::vector<std::string>& result, std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations);
+
+    // Intern the word of each hit in band.all and append the hits to results
+    static void appendAll(const std::vector<std::vector<char>>& grid, BandResult& band, SearchResults& results);
+
+    // Run scanBand over start rows [rowBegin, rowEnd) into bands, on one thread or split into row bands.
+    // Each scan starts from a copy of seed, or from the trie's ignore marks when seed is nullptr.
+    void runBands(const std::vector<std::vector<char>>& grid, int cols, const FlatTrie& trie, int minWordLength, int threads, bool allHits, int rowBegin, int rowEnd, const std::vector<uint64_t>* seed);
+
+    // Reset a reported bitset to the trie's ignore marks, so ignored words look already reported
+    static void resetReported(const FlatTrie& trie, std::vector<uint64_t>& reported);
+
+    // Count the reportable words below each node, when the trie or minimum length changed
+    void prepareCounts(const FlatTrie& trie, int minWordLength);
+
+    SearchStats* stats;  // Counters for the current search, or nullptr
+    std::vector<uint64_t> reported;  // Reported bitset for single-threaded searches, reused between searches
+    std::vector<BandResult> bands;  // Per-band results, reused between searches
+    std::vector<uint64_t> windowReported;  // Words reported by earlier windows, plus the ignore marks
+    BigramFilter filter;  // Start cells worth walking, rebuilt from the trie by runBands
+
+    bool firstOnly;  // Mode requested with setFirstOnly
+    const FlatTrie* countedTrie;  // Trie and minimum length the counts below were made for
+    size_t countedNodes;
+    int countedMinLength;
+    std::vector<uint32_t> counts;  // Reportable words at or below each node
+    std::vector<uint32_t> remaining;  // counts less the words reported, for single-threaded searches
+};
+
+#endif // LINESCAN_H
@@ -4,36 +4,159 @@
 # Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
 # This software is released under the MIT License.
 # See the LICENSE file in the project root for the full license text.
-# Last revised 16/10/2024
+# Last revised 16/10/2026
 #-----------------------------------------------------------------------
 # Version      Date         Notes:
 # 2024.10.1    15.10.2024   Initial version, integrates grid search and trie
 # 2024.10.2    16.10.2024   Fixed NaN issue in CSV word loading
 # 2024.10.3    16.10.2024   Removed all spaces from loaded words and ignore list
 # 2024.10.4    16.10.2024   Added switches for ignore words file and minimum word length
+# 2026.10.1    15.10.2026   Added -e switch to run the search on the arena-backed FlatTrie
+# 2026.10.2    15.10.2026   Added the iterative straight-line scan engine
+# 2026.10.3    15.10.2026   Added -j switch for a multithreaded scan
+# 2026.10.4    15.10.2026   Added the Aho-Corasick engine
+# 2026.10.5    15.10.2026   Added --compile and memory-mapped compiled dictionaries
+# 2026.10.6    15.10.2026   Added --stats phase timings, trie size and search counters
+# 2026.10.7    15.10.2026   Ignore list marked in the FlatTrie for the flat, scan and ac engines
+# 2026.10.8    15.10.2026   Added -a switch to report every occurrence of each word
+# 2026.10.9    15.10.2026   --stats reports CSV bytes read and load throughput
+# 2026.10.10   15.10.2026   Added --batch to search many grids against one loaded dictionary
+# 2026.10.11   15.10.2026   Added --serve to answer searches over a Unix domain socket
+# 2026.10.12   15.10.2026   Added --stream to search grids larger than memory band by band
+# 2026.10.13   15.10.2026   --stats reports walks skipped by the bigram prefilter and its kernel
+# 2026.10.14   15.10.2026   Added the dawg engine, DFS over a minimised Dawg dictionary
+# 2026.10.15   15.10.2026   Added the boggle engine, free paths through adjacent cells, and --max-path
+# 2026.10.16   16.10.2026   Added -k switch for words within a number of mismatched letters
+# 2026.10.17   16.10.2026   Added --first-only to prune subtrees whose words have all been found
+# 2026.10.18   16.10.2026   Results written through a buffered ResultWriter, --format picks text, json, csv or bin
+# 2026.10.19   16.10.2026   Added --load-threads to build the dfs engine's Trie in parallel
+# 2026.10.20   16.10.2026   -j and --load-threads capped at maxThreads
 ****************************************************************/
 
 #include "gridsearch.h"
 #include "trie.h"
+#include "flattrie.h"
+#include "dawg.h"
+#include "boggle.h"
+#include "fuzzy.h"
+#include "linescan.h"
+#include "ahocorasick.h"
+#include "searchstats.h"
+#include "wordtable.h"
+#include "batch.h"
+#include "server.h"
+#include "gridstream.h"
+#include "bigramfilter.h"
+#include "resultwriter.h"
 #include <iostream>
 #include <vector>
 #include <set>
 #include <stdexcept>  // For exception handling
 #include <cstring>    // For strcmp
+#include <algorithm>  // For max
+#include <thread>     // For hardware_concurrency
+#include <chrono>     // For phase timings
+#include <memory>     // For unique_ptr
 
 using namespace std;
 
+// Most threads -j and --load-threads start; larger counts are capped to this
+static const int maxThreads = 1024;
+
 // Function to display help information, showing available command-line options.
 void displayHelp()
 {
     cout << "Usage: ./program <csv_grid_file> <csv_words_file> [options]\n"
+         << "       ./program <grid_source> <csv_words_file> --batch <dir|manifest|multi> [options]\n"
+         << "       ./program --serve <socket_path> <csv_words_file> [options]\n"
+         << "       ./program --compile <csv_words_file> <compiled_dictionary_file>\n"
+         << "The words file may also be a compiled dictionary, which is memory-mapped instead of parsed.\n"
          << "Options:\n"
          << "  -i <csv_ignore_words_file>   Specify a CSV file with words to ignore (optional)\n"
          << "  -n <min_word_length>         Specify the minimum word length to search for (optional, default: 3)\n"
+         << "  -e <engine>                  Search engine: dfs, flat, scan, ac, dawg or boggle (optional, default: dfs)\n"
+         << "                               boggle finds words along paths that may turn at any cell, using no cell twice\n"
+         << "  -j <threads>                 Number of search threads for the scan and boggle engines, 0 for all cores (optional, default: 1)\n"
+         << "  --load-threads <threads>     Threads building the dictionary for the dfs engine, 0 for all cores\n"
+         << "                               (optional, default: 1)\n"
+         << "  --max-path <cells>           Longest path the boggle engine walks, 0 for no cap (optional, default: 0)\n"
+         << "  -k <mismatches>              Also find words with up to this many grid letters wrong, reporting the\n"
+         << "                               dictionary word and its mismatch count (scan engine only)\n"
+         << "  --batch <kind>               Search many grids, one JSON line per grid. The first argument is a directory\n"
+         << "                               of CSV grids (dir), a file listing grid files (manifest), or one file of\n"
+         << "                               grids separated by lines starting with --- (multi). -j sets how many grids\n"
+         << "                               are searched at once, with any engine\n"
+         << "  --serve <socket_path>        (First argument) keep the dictionary loaded and answer SEARCH and STATS\n"
+         << "                               requests on a Unix domain socket; -j sets the number of search workers\n"
+         << "  --stream <band_rows>         Read the grid in bands of this many rows while searching, so grids larger\n"
+         << "                               than memory can be searched (scan engine only)\n"
+         << "  --first-only                 Stop walking where every word below has been found, and stop the search\n"
+         << "                               once every word is found; same output (dfs, flat and scan engines)\n"
+         << "  --format <format>            Output format: text, json, csv or bin, fixed-width binary records\n"
+         << "                               (optional, default: text)\n"
+         << "  -a                           Report every occurrence of each word, not just the first (scan engine only)\n"
+         << "  --stats                      Print phase timings, trie size and search counters as JSON on stderr\n"
          << "  -h                           Display this help message\n"
          << endl;
 }
 
+// Milliseconds elapsed since start, for the --stats phase timings
+static double elapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Megabytes per second for bytes read in ms milliseconds, 0 when nothing was timed
+static double throughputMBs(size_t bytes, double ms)
+{
+    return ms > 0 ? (bytes / 1e6) / (ms / 1e3) : 0;
+}
+
+// Print the --stats report as a single JSON object on stderr
+static void printStats(const string& engine, int threads, int loadThreads, const double phaseMs[5], const size_t inputBytes[3], size_t trieNodes, size_t trieBytes, bool trieMapped, size_t automatonBytes, size_t rows, size_t cols, size_t found, OutputFormat format, size_t outputBytes, const SearchStats& stats, const StreamSummary* stream)
+{
+    const char* phaseNames[] = {"ignore_load", "word_load", "grid_load", "search", "output"};
+    double totalMs = 0;
+
+    cerr << "{\"engine\": \"" << engine << "\", \"threads\": " << threads << ", \"load_threads\": " << loadThreads << ", \"phases_ms\": {";
+    for (int p = 0; p < 5; p++)
+    {
+        cerr << "\"" << phaseNames[p] << "\": " << phaseMs[p] << ", ";
+        totalMs += phaseMs[p];
+    }
+    cerr << "\"total\": " << totalMs << "}"
+         << ", \"input_bytes\": {\"ignore\": " << inputBytes[0] << ", \"words\": " << inputBytes[1] << ", \"grid\": " << inputBytes[2] << "}"
+         << ", \"throughput_mb_s\": {\"ignore_load\": " << throughputMBs(inputBytes[0], phaseMs[0])
+         << ", \"word_load\": " << throughputMBs(inputBytes[1], phaseMs[1])
+         << ", \"grid_load\": " << throughputMBs(inputBytes[2], phaseMs[2]) << "}"
+         << ", \"trie\": {\"type\": \"" << (engine == "dfs" ? "pointer" : (engine == "dawg" ? "dawg" : "flat")) << "\", \"nodes\": " << trieNodes
+         << ", \"bytes\": " << trieBytes << ", \"mapped\": " << (trieMapped ? "true" : "false")
+         << ", \"automaton_bytes\": " << automatonBytes << "}"
+         << ", \"grid\": {\"rows\": " << rows << ", \"cols\": " << cols << "}";
+    if (stream)
+    {
+        // The grid was read on a second thread during the search phase; wait is how long the search sat idle for it
+        cerr << ", \"stream\": {\"bands\": " << stream->bands << ", \"band_rows\": " << stream->bandRows
+             << ", \"overlap_rows\": " << stream->overlapRows << ", \"peak_window_rows\": " << stream->peakWindowRows
+             << ", \"read_ms\": " << stream->readMs << ", \"read_mb_s\": " << throughputMBs(stream->fileBytes, stream->readMs)
+             << ", \"wait_ms\": " << stream->waitMs << "}";
+    }
+    cerr
+         << ", \"found\": " << found
+         << ", \"output\": {\"format\": \"" << outputFormatName(format) << "\", \"bytes\": " << outputBytes << "}"
+         << ", \"prefilter\": \"" << BigramFilter::kernelName(BigramFilter::activeKernel()) << "\""
+         << ", \"counters\": {\"walks_started\": " << stats.walksStarted
+         << ", \"walks_skipped\": " << stats.walksSkipped
+         << ", \"trie_steps\": " << stats.trieSteps
+         << ", \"pruned_at_depth_one\": " << stats.prunedAtDepthOne
+         << ", \"hits\": " << stats.hits
+         << ", \"accepted\": " << stats.accepted
+         << ", \"rejected_min_length\": " << stats.rejectedMinLength
+         << ", \"rejected_duplicate\": " << stats.rejectedDuplicate
+         << ", \"rejected_ignored\": " << stats.rejectedIgnored
+         << ", \"exhausted_prunes\": " << stats.exhaustedPrunes << "}}" << endl;
+}
+
 int main(int argc, char* argv[])
 {
     // Parse command-line arguments to check for help flag, ignore words file, and minimum word length
@@ -46,28 +169,63 @@ int main(int argc, char* argv[])
         }
     }
 
+    // Compile a words CSV file into a dictionary that later runs can memory-map
+    if (argc > 1 && strcmp(argv[1], "--compile") == 0)
+    {
+        if (argc != 4)
+        {
+            cerr << "Error: --compile needs a CSV words file and an output file. Use -h for help.\n";
+            return 1;
+        }
+
+        FlatTrie compiledTrie;
+        loadWordsFromCSVFile(argv[2], compiledTrie);
+        if (!compiledTrie.saveCompiled(argv[3]))
+        {
+            return 1;
+        }
+        cout << "Compiled " << compiledTrie.nodeCount() << " nodes (" << compiledTrie.bytes() << " bytes) into " << argv[3] << endl;
+        return 0;
+    }
+
+    // Server mode takes the socket path in place of the grid file, one argument further along
+    bool serve = argc > 1 && strcmp(argv[1], "--serve") == 0;
+    int firstArg = serve ? 2 : 1;
+
     // Check if at least two file names were passed as command-line arguments (grid and words file)
-    if (argc < 3)
+    if (argc < firstArg + 2)
     {
         cerr << "Error: Not enough arguments provided. Use -h for help.\n";
         return 1;
     }
 
-    string csvFileName = argv[1];   // Get the CSV grid file name from the command-line argument
-    string wordsFileName = argv[2]; // Get the CSV dictionary file name from the second argument
+    string csvFileName = argv[firstArg];       // Get the CSV grid file name (or socket path) from the command-line argument
+    string wordsFileName = argv[firstArg + 1]; // Get the CSV dictionary file name from the next argument
 
     set<string> ignoreWords;  // Set to store ignore words (initially empty)
+    string ignoreFileName;    // Ignore words file, loaded once the options are parsed
+    bool showStats = false;   // Print phase timings and counters on stderr
+    bool allOccurrences = false;  // Report every occurrence instead of the first of each word
+    string batchKind;         // Batch source kind, empty for a single grid
     int minWordLength = 3;    // Default minimum word length
+    string engine = "dfs";    // Default search engine
+    int threads = 1;          // Default number of search threads
+    int loadThreads = 1;      // Threads building the pointer Trie
+    size_t streamRows = 0;    // Rows per band when streaming the grid, 0 to load it whole
+    int maxPath = 0;          // Longest boggle path, 0 for no cap
+    int maxMismatches = -1;   // Mismatched letters allowed per word, -1 for an exact search
+    bool firstOnly = false;   // Prune subtrees whose words have all been found
+    OutputFormat format = OutputFormat::Text;  // How found words are written to stdout
+    bool formatGiven = false;  // --format was on the command line
 
     // Parse additional optional arguments for ignore file and minimum word length
-    for (int i = 3; i < argc; ++i)
+    for (int i = firstArg + 2; i < argc; ++i)
     {
         if (strcmp(argv[i], "-i") == 0)  // Check for ignore words file switch
         {
             if (i + 1 < argc)  // Ensure there is a file name after the switch
             {
-                string ignoreFileName = argv[++i];
-                ignoreWords = loadIgnoreWordsFromCSV(ignoreFileName);
+                ignoreFileName = argv[++i];
             }
             else
             {
@@ -95,6 +253,206 @@ int main(int argc, char* argv[])
                 return 1;
             }
         }
+        else if (strcmp(argv[i], "-e") == 0)  // Check for search engine switch
+        {
+            if (i + 1 < argc)  // Ensure there is an engine name after the switch
+            {
+                engine = argv[++i];
+                if (engine != "dfs" && engine != "flat" && engine != "scan" && engine != "ac" && engine != "dawg" && engine != "boggle")
+                {
+                    cerr << "Error: Unknown search engine " << engine << ". Use dfs, flat, scan, ac, dawg or boggle." << endl;
+                    return 1;
+                }
+            }
+            else
+            {
+                cerr << "Error: No search engine specified after -e." << endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--load-threads") == 0)  // Check for dictionary build threads switch
+        {
+            if (i + 1 < argc)  // Ensure there is a number after the switch
+            {
+                try
+                {
+                    loadThreads = stoi(argv[++i]);  // Get the number of build threads
+                }
+                catch (const invalid_argument& e)
+                {
+                    cerr << "Error: Invalid number of load threads provided. It must be a number." << endl;
+                    return 1;
+                }
+                if (loadThreads < 0)
+                {
+                    cerr << "Error: Number of load threads cannot be negative." << endl;
+                    return 1;
+                }
+                if (loadThreads == 0)
+                {
+                    loadThreads = max(1u, thread::hardware_concurrency());  // Use every core
+                }
+                loadThreads = min(loadThreads, maxThreads);
+            }
+            else
+            {
+                cerr << "Error: No number of load threads specified after --load-threads." << endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-j") == 0)  // Check for search threads switch
+        {
+            if (i + 1 < argc)  // Ensure there is a number after the switch
+            {
+                try
+                {
+                    threads = stoi(argv[++i]);  // Get the number of search threads
+                }
+                catch (const invalid_argument& e)
+                {
+                    cerr << "Error: Invalid number of threads provided. It must be a number." << endl;
+                    return 1;
+                }
+                if (threads < 0)
+                {
+                    cerr << "Error: Number of threads cannot be negative." << endl;
+                    return 1;
+                }
+                if (threads == 0)
+                {
+                    threads = max(1u, thread::hardware_concurrency());  // Use every core
+                }
+                threads = min(threads, maxThreads);
+            }
+            else
+            {
+                cerr << "Error: No number of threads specified after -j." << endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-a") == 0)  // Check for all-occurrences switch
+        {
+            allOccurrences = true;
+        }
+        else if (strcmp(argv[i], "--first-only") == 0)  // Check for first-only pruning switch
+        {
+            firstOnly = true;
+        }
+        else if (strcmp(argv[i], "--batch") == 0)  // Check for batch mode switch
+        {
+            if (i + 1 < argc)  // Ensure there is a source kind after the switch
+            {
+                batchKind = argv[++i];
+                if (batchKind != "dir" && batchKind != "manifest" && batchKind != "multi")
+                {
+                    cerr << "Error: Unknown batch source " << batchKind << ". Use dir, manifest or multi." << endl;
+                    return 1;
+                }
+            }
+            else
+            {
+                cerr << "Error: No batch source kind specified after --batch." << endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--stream") == 0)  // Check for streamed grid switch
+        {
+            if (i + 1 < argc)  // Ensure there is a number after the switch
+            {
+                try
+                {
+                    int bandRows = stoi(argv[++i]);  // Get the rows per band
+                    if (bandRows <= 0)
+                    {
+                        cerr << "Error: Band rows for --stream must be positive." << endl;
+                        return 1;
+                    }
+                    streamRows = static_cast<size_t>(bandRows);
+                }
+                catch (const invalid_argument& e)
+                {
+                    cerr << "Error: Invalid band rows provided. It must be a number." << endl;
+                    return 1;
+                }
+            }
+            else
+            {
+                cerr << "Error: No band rows specified after --stream." << endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--max-path") == 0)  // Check for boggle path cap switch
+        {
+            if (i + 1 < argc)  // Ensure there is a number after the switch
+            {
+                try
+                {
+                    maxPath = stoi(argv[++i]);  // Get the longest path in cells
+                }
+                catch (const invalid_argument& e)
+                {
+                    cerr << "Error: Invalid maximum path length provided. It must be a number." << endl;
+                    return 1;
+                }
+                if (maxPath < 0)
+                {
+                    cerr << "Error: Maximum path length cannot be negative." << endl;
+                    return 1;
+                }
+            }
+            else
+            {
+                cerr << "Error: No maximum path length specified after --max-path." << endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-k") == 0)  // Check for fuzzy search switch
+        {
+            if (i + 1 < argc)  // Ensure there is a number after the switch
+            {
+                try
+                {
+                    maxMismatches = stoi(argv[++i]);  // Get the mismatches allowed per word
+                }
+                catch (const invalid_argument& e)
+                {
+                    cerr << "Error: Invalid number of mismatches provided. It must be a number." << endl;
+                    return 1;
+                }
+                if (maxMismatches < 0)
+                {
+                    cerr << "Error: Number of mismatches cannot be negative." << endl;
+                    return 1;
+                }
+            }
+            else
+            {
+                cerr << "Error: No number of mismatches specified after -k." << endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--format") == 0)  // Check for output format switch
+        {
+            if (i + 1 < argc)  // Ensure there is a format name after the switch
+            {
+                string formatName = argv[++i];
+                if (!parseOutputFormat(formatName, format))
+                {
+                    cerr << "Error: Unknown output format " << formatName << ". Use text, json, csv or bin." << endl;
+                    return 1;
+                }
+                formatGiven = true;
+            }
+            else
+            {
+                cerr << "Error: No output format specified after --format." << endl;
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--stats") == 0)  // Check for statistics switch
+        {
+            showStats = true;
+        }
         else
         {
             cerr << "Error: Unknown option " << argv[i] << endl;
@@ -102,37 +460,276 @@ int main(int argc, char* argv[])
         }
     }
 
-    // Create and initialize a Trie
+    if (serve && !batchKind.empty())
+    {
+        cerr << "Error: --serve and --batch cannot be combined." << endl;
+        return 1;
+    }
+    if (threads > 1 && engine != "scan" && engine != "boggle" && batchKind.empty() && !serve)
+    {
+        cerr << "Error: -j is only supported by the scan and boggle engines." << endl;
+        return 1;
+    }
+    if (loadThreads > 1 && engine != "dfs")
+    {
+        cerr << "Error: --load-threads is only supported by the dfs engine, which searches the pointer Trie." << endl;
+        return 1;
+    }
+    if (maxPath > 0 && engine != "boggle")
+    {
+        cerr << "Error: --max-path is only supported by the boggle engine." << endl;
+        return 1;
+    }
+    if (allOccurrences && engine != "scan")
+    {
+        cerr << "Error: -a is only supported by the scan engine." << endl;
+        return 1;
+    }
+    if (firstOnly && ((engine != "dfs" && engine != "flat" && engine != "scan") || allOccurrences || streamRows > 0 || maxMismatches >= 0))
+    {
+        cerr << "Error: --first-only is only supported by the dfs, flat and scan engines, without -a, --stream or -k." << endl;
+        return 1;
+    }
+    if (engine == "dawg" && (serve || !batchKind.empty()))
+    {
+        cerr << "Error: The dawg engine is only supported for a single grid." << endl;
+        return 1;
+    }
+    if (maxMismatches >= 0 && (engine != "scan" || threads > 1 || allOccurrences || streamRows > 0 || serve || !batchKind.empty()))
+    {
+        cerr << "Error: -k is only supported by the single-threaded scan engine, without -a, --stream, --batch or --serve." << endl;
+        return 1;
+    }
+    if (formatGiven && (serve || !batchKind.empty()))
+    {
+        cerr << "Error: --format is only supported for a single grid; --batch and --serve write JSON lines." << endl;
+        return 1;
+    }
+    if (streamRows > 0 && (engine != "scan" || allOccurrences || serve || !batchKind.empty()))
+    {
+        cerr << "Error: --stream is only supported by the scan engine, without -a, --batch or --serve." << endl;
+        return 1;
+    }
+
+    double phaseMs[5] = {0, 0, 0, 0, 0};  // ignore load, word load, grid load, search, output
+    size_t inputBytes[3] = {0, 0, 0};     // CSV bytes parsed for the ignore, words and grid files
+    auto phaseStart = chrono::steady_clock::now();
+
+    // Load the ignore words, if an ignore file was given
+    if (!ignoreFileName.empty())
+    {
+        ignoreWords = loadIgnoreWordsFromCSV(ignoreFileName, &inputBytes[0]);
+    }
+    phaseMs[0] = elapsedMs(phaseStart);
+    phaseStart = chrono::steady_clock::now();
+
+    // Create and initialize the Trie used by the selected engine
     Trie myTrie;
+    FlatTrie myFlatTrie;
+    Dawg myDawg;
+    bool flat = engine != "dfs" && engine != "dawg";  // Engines searching the FlatTrie
+
+    // Load the words into the Trie from the specified CSV file, or map a compiled dictionary
+    if (FlatTrie::isCompiledFile(wordsFileName))
+    {
+        if (!flat)
+        {
+            cerr << "Error: Compiled dictionaries need a FlatTrie engine (flat, scan, ac or boggle)." << endl;
+            return 1;
+        }
+        if (!myFlatTrie.loadCompiled(wordsFileName))
+        {
+            return 1;
+        }
+    }
+    else if (engine == "dawg")
+    {
+        loadWordsFromCSVFile(wordsFileName, myDawg, &inputBytes[1]);
+    }
+    else if (flat)
+    {
+        loadWordsFromCSVFile(wordsFileName, myFlatTrie, &inputBytes[1]);
+    }
+    else if (loadThreads > 1)
+    {
+        loadWordsFromCSVFile(wordsFileName, myTrie, loadThreads, &inputBytes[1]);
+    }
+    else
+    {
+        loadWordsFromCSVFile(wordsFileName, myTrie, &inputBytes[1]);
+    }
+
+    // FlatTrie engines reject ignored words with a per-node bit instead of a set lookup
+    if (flat && !ignoreWords.empty())
+    {
+        myFlatTrie.markIgnored(ignoreWords);
+    }
 
-    // Load the words into the Trie from the specified CSV file
-    loadWordsFromCSVFile(wordsFileName, myTrie);
+    phaseMs[1] = elapsedMs(phaseStart);
+    phaseStart = chrono::steady_clock::now();
 
-    // Populate the grid with characters from the CSV grid file
-    vector<vector<char>> grid = readCSVFile(csvFileName);
+    // Batch and server modes: the dictionary stays loaded while many grids are searched
+    BatchConfig config;
+    config.engine = engine;
+    config.minWordLength = minWordLength;
+    config.threads = threads;
+    config.allOccurrences = allOccurrences;
+    config.maxPath = maxPath;
+    config.firstOnly = firstOnly;
+
+    unique_ptr<AhoCorasick> sharedAutomaton;
+    if ((serve || !batchKind.empty()) && engine == "ac")
+    {
+        sharedAutomaton.reset(new AhoCorasick(myFlatTrie));  // Built once, shared read-only by every thread
+    }
+
+    if (serve)
+    {
+        GridServer server(config, &myTrie, &myFlatTrie, sharedAutomaton.get(), ignoreWords);
+        return server.run(csvFileName) ? 0 : 1;
+    }
+
+    if (!batchKind.empty())
+    {
+        GridSource source;
+        if (!source.open(csvFileName, batchKind))
+        {
+            return 1;
+        }
+        double setupMs = elapsedMs(phaseStart);
+
+        phaseStart = chrono::steady_clock::now();
+        BatchSummary summary = runBatch(source, config, &myTrie, &myFlatTrie, sharedAutomaton.get(), ignoreWords, cout);
+        double batchMs = elapsedMs(phaseStart);
+
+        if (showStats)
+        {
+            cerr << "{\"engine\": \"" << engine << "\", \"threads\": " << threads << ", \"batch\": \"" << batchKind << "\""
+                 << ", \"phases_ms\": {\"ignore_load\": " << phaseMs[0] << ", \"word_load\": " << phaseMs[1]
+                 << ", \"setup\": " << setupMs << ", \"grids\": " << batchMs << "}"
+                 << ", \"grids\": " << summary.grids << ", \"failed\": " << summary.failed << ", \"found\": " << summary.found
+                 << ", \"grid_bytes\": " << summary.gridBytes
+                 << ", \"grids_per_s\": " << (batchMs > 0 ? summary.grids / (batchMs / 1e3) : 0) << "}" << endl;
+        }
+        return summary.failed == 0 ? 0 : 1;
+    }
 
-    // Check if the grid was successfully loaded
-    if (grid.empty())
+    // Populate the grid with characters from the CSV grid file; a streamed grid is read during the search
+    vector<vector<char>> grid;
+    if (streamRows == 0)
     {
-        cerr << "Error: Grid could not be loaded from CSV file." << endl;
-        return 1;  // Exit with error
+        grid = readCSVFile(csvFileName, &inputBytes[2]);
+        phaseMs[2] = elapsedMs(phaseStart);
+
+        // Check if the grid was successfully loaded
+        if (grid.empty())
+        {
+            cerr << "Error: Grid could not be loaded from CSV file." << endl;
+            return 1;  // Exit with error
+        }
     }
 
     // Create a GridSearch object
     GridSearch gridSearch;
+    gridSearch.setFirstOnly(firstOnly);
+
+    // Search counters, only collected with --stats
+    SearchStats searchStats;
+    SearchStats* statsTarget = showStats ? &searchStats : nullptr;
+    gridSearch.setStats(statsTarget);
+    size_t automatonBytes = 0;
 
     // Vector to store found words and their locations (start and end)
     vector<pair<string, pair<pair<int, int>, pair<int, int>>>> wordLocations;
 
     // Use GridSearch to find all words in the grid that are in the Trie, along with their locations
-    vector<string> foundWords = gridSearch.searchWords(grid, &myTrie, wordLocations, ignoreWords, minWordLength);
+    phaseStart = chrono::steady_clock::now();
+    vector<string> foundWords;
+    vector<int> wordMismatches;  // Mismatch count of each entry in wordLocations, filled with -k
+    SearchResults allResults;  // Every occurrence, filled instead of wordLocations with -a
+    StreamSummary streamSummary = {};
+    if (streamRows > 0)
+    {
+        LineScanner lineScanner;
+        lineScanner.setStats(statsTarget);
+        streamSummary = searchGridStream(csvFileName, myFlatTrie, lineScanner, streamRows, minWordLength, threads, foundWords, wordLocations);
+        if (streamSummary.rows == 0)
+        {
+            cerr << "Error: Grid could not be loaded from CSV file." << endl;
+            return 1;
+        }
+        inputBytes[2] = streamSummary.fileBytes;  // Read time is in the stream report, it overlaps the search
+    }
+    else if (maxMismatches >= 0)
+    {
+        FuzzyScanner fuzzyScanner(myFlatTrie);
+        fuzzyScanner.setStats(statsTarget);
+        foundWords = fuzzyScanner.searchWords(grid, wordLocations, wordMismatches, minWordLength, maxMismatches);
+    }
+    else if (engine == "scan" && allOccurrences)
+    {
+        LineScanner lineScanner;
+        lineScanner.setStats(statsTarget);
+        lineScanner.searchAll(grid, myFlatTrie, allResults, minWordLength, threads);
+    }
+    else if (engine == "scan")
+    {
+        LineScanner lineScanner;
+        lineScanner.setStats(statsTarget);
+        lineScanner.setFirstOnly(firstOnly);
+        foundWords = lineScanner.searchWords(grid, myFlatTrie, wordLocations, minWordLength, threads);
+    }
+    else if (engine == "ac")
+    {
+        AhoCorasick automaton(myFlatTrie);
+        automaton.setStats(statsTarget);
+        foundWords = automaton.searchWords(grid, wordLocations, minWordLength);
+        automatonBytes = automaton.bytes();
+    }
+    else if (engine == "boggle")
+    {
+        BoggleSearch boggle;
+        boggle.setStats(statsTarget);
+        foundWords = boggle.searchWords(grid, myFlatTrie, wordLocations, minWordLength, maxPath, threads);
+    }
+    else if (engine == "flat")
+    {
+        foundWords = gridSearch.searchWords(grid, &myFlatTrie, wordLocations, ignoreWords, minWordLength);
+    }
+    else if (engine == "dawg")
+    {
+        foundWords = gridSearch.searchWords(grid, &myDawg, wordLocations, ignoreWords, minWordLength);
+    }
+    else
+    {
+        foundWords = gridSearch.searchWords(grid, &myTrie, wordLocations, ignoreWords, minWordLength);
+    }
+    phaseMs[3] = elapsedMs(phaseStart);
+    phaseStart = chrono::steady_clock::now();
+
+    // Output the found words and their start and end positions in the grid, buffered rather than flushed line by line
+    size_t outputBytes = 0;
+    {
+        ResultWriter writer(cout, format);
+        if (allOccurrences)
+        {
+            writer.write(allResults);
+        }
+        else
+        {
+            writer.write(wordLocations, wordMismatches);
+        }
+        outputBytes = writer.bytesWritten();
+    }
+    phaseMs[4] = elapsedMs(phaseStart);
 
-    // Output the found words and their start and end positions in the grid
-    cout << "Found words and their locations: " << endl;
-    for (const auto& entry : wordLocations)
+    if (showStats)
     {
-        cout << "Word: " << entry.first << " from position (" << entry.second.first.first << ", " << entry.second.first.second
-             << ") to position (" << entry.second.second.first << ", " << entry.second.second.second << ")" << endl;
+        size_t trieNodes = flat ? myFlatTrie.nodeCount() : (engine == "dawg" ? myDawg.nodeCount() : myTrie.nodeCount());
+        size_t trieBytes = flat ? myFlatTrie.bytes() : (engine == "dawg" ? myDawg.bytes() : myTrie.bytes());
+        printStats(engine, threads, loadThreads, phaseMs, inputBytes, trieNodes, trieBytes,
+                   myFlatTrie.isMapped(), automatonBytes, streamRows > 0 ? streamSummary.rows : grid.size(), streamRows > 0 ? streamSummary.cols : grid[0].size(),
+                   allOccurrences ? allResults.hits.size() : foundWords.size(), format, outputBytes, searchStats, streamRows > 0 ? &streamSummary : nullptr);
     }
 
     return 0;
@@ -0,0 +1,271 @@
+/***************************************************************
+# mappedfile.cpp
+# Code implementing read-only memory mapped files for POSIX and Windows
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of MappedFile class
+# 2026.10.2    15.10.2026   Added release to drop pages that have been read
+# 2026.10.3    16.10.2026   Non-regular files read with read() instead of failing to map
+****************************************************************/
+
+#include "mappedfile.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Constructor, nothing mapped yet
+MappedFile::MappedFile()
+    : mapData(nullptr), mapSize(0), opened(false)
+#ifdef _WIN32
+    , fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+#endif
+{
+}
+
+// Destructor, unmaps the file if one is still mapped
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+// Move constructor, takes over the other mapping
+MappedFile::MappedFile(MappedFile&& other)
+    : MappedFile()
+{
+    *this = std::move(other);
+}
+
+// Move assignment, releases our mapping and takes over the other one
+MappedFile& MappedFile::operator=(MappedFile&& other)
+{
+    if (this != &other)
+    {
+        close();
+        readData = std::move(other.readData);
+        mapData = readData.empty() ? other.mapData : readData.data();
+        mapSize = other.mapSize;
+        opened = other.opened;
+#ifdef _WIN32
+        fileHandle = other.fileHandle;
+        mappingHandle = other.mappingHandle;
+        other.fileHandle = INVALID_HANDLE_VALUE;
+        other.mappingHandle = nullptr;
+#endif
+        other.mapData = nullptr;
+        other.mapSize = 0;
+        other.opened = false;
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+
+// Map the whole file read-only using a Windows file mapping, or read it when it is not a disk file
+bool MappedFile::open(const string& filename)
+{
+    close();
+
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    // Pipes and consoles cannot be mapped; read them to the end instead
+    if (GetFileType(fileHandle) != FILE_TYPE_DISK)
+    {
+        char chunk[65536];
+        DWORD received = 0;
+        BOOL ok;
+        while ((ok = ReadFile(fileHandle, chunk, sizeof(chunk), &received, nullptr)) && received > 0)
+        {
+            readData.insert(readData.end(), chunk, chunk + received);
+        }
+        bool ended = ok || GetLastError() == ERROR_BROKEN_PIPE;  // A pipe reports its end as a broken pipe
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+        if (ended)
+        {
+            opened = true;
+            mapSize = readData.size();
+            mapData = readData.empty() ? nullptr : readData.data();
+            return true;
+        }
+        close();
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize))
+    {
+        close();
+        return false;
+    }
+
+    opened = true;
+    mapSize = static_cast<size_t>(fileSize.QuadPart);
+    if (mapSize == 0)
+    {
+        return true;  // Nothing to map, an empty file is still a valid file
+    }
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    mapData = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (mapData == nullptr)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Unmap the view and release both handles
+void MappedFile::close()
+{
+    if (mapData != nullptr && readData.empty())
+    {
+        UnmapViewOfFile(mapData);
+    }
+    vector<char>().swap(readData);
+    if (mappingHandle != nullptr)
+    {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(fileHandle);
+    }
+    mapData = nullptr;
+    mapSize = 0;
+    opened = false;
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+}
+
+// Windows unmaps pages of a read-only view under memory pressure on its own
+void MappedFile::release(size_t, size_t)
+{
+}
+
+#else
+
+// Map the whole file read-only with mmap; the descriptor is not needed after mapping.
+// A file that is not a regular file is read into readData instead.
+bool MappedFile::open(const string& filename)
+{
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // Pipes, FIFOs and terminals cannot be mapped and report no useful size; read them to the end instead
+    if (!S_ISREG(info.st_mode))
+    {
+        char chunk[65536];
+        ssize_t received;
+        while ((received = ::read(fd, chunk, sizeof(chunk))) != 0)
+        {
+            if (received < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ::close(fd);
+                close();
+                return false;
+            }
+            readData.insert(readData.end(), chunk, chunk + received);
+        }
+        ::close(fd);
+        opened = true;
+        mapSize = readData.size();
+        mapData = readData.empty() ? nullptr : readData.data();
+        return true;
+    }
+
+    opened = true;
+    mapSize = static_cast<size_t>(info.st_size);
+    if (mapSize == 0)
+    {
+        ::close(fd);
+        return true;  // Nothing to map, an empty file is still a valid file
+    }
+
+    void* mapped = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        mapSize = 0;
+        opened = false;
+        return false;
+    }
+
+    mapData = static_cast<const char*>(mapped);
+    return true;
+}
+
+// Unmap the file, or free the bytes read from it
+void MappedFile::close()
+{
+    if (mapData != nullptr && readData.empty())
+    {
+        munmap(const_cast<char*>(mapData), mapSize);
+    }
+    vector<char>().swap(readData);
+    mapData = nullptr;
+    mapSize = 0;
+    opened = false;
+}
+
+// Drop the pages of [begin, end) from this process; they are read back from the file if touched again,
+// so a partial page at begin that was already released is harmless
+void MappedFile::release(size_t begin, size_t end)
+{
+    if (mapData == nullptr || !readData.empty())
+    {
+        return;
+    }
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    begin = begin / page * page;  // The mapping is page aligned, so offsets round like addresses
+    end = min(end, mapSize) / page * page;  // Keep the page holding end, it is still being read
+    if (begin < end)
+    {
+        madvise(const_cast<char*>(mapData) + begin, end - begin, MADV_DONTNEED);
+    }
+}
+
+#endif
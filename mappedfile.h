@@ -0,0 +1,60 @@
+/***************************************************************
+# mappedfile.h
+# Header for mappedfile.cpp, defines the read-only MappedFile class
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of MappedFile class
+# 2026.10.2    15.10.2026   Added release to drop pages that have been read
+# 2026.10.3    16.10.2026   Pipes and other unmappable files are read into an owned buffer
+****************************************************************/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// MappedFile class definition.
+// Maps a whole file read-only into memory (mmap on POSIX, a file mapping on
+// Windows) and unmaps it again when closed or destroyed. A file that cannot be
+// mapped because it is not a regular file (a pipe, FIFO or /dev/stdin) is read
+// to its end into an owned buffer instead. Movable, not copyable.
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other);
+    MappedFile& operator=(MappedFile&& other);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename);  // Map or read the file, returns false if it cannot be opened or read
+    void close();  // Unmap the file, safe to call when nothing is mapped
+
+    // Tell the OS the bytes in [begin, end) will not be read again, so their pages can be
+    // dropped from memory. The page holding end is kept; a no-op on Windows.
+    void release(size_t begin, size_t end);
+
+    const char* data() const { return mapData; }  // Start of the mapped or read bytes
+    size_t size() const { return mapSize; }  // Number of mapped bytes
+    bool isOpen() const { return opened; }
+
+private:
+    const char* mapData;
+    size_t mapSize;
+    bool opened;
+    std::vector<char> readData;  // Contents of a file that could not be mapped
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,150 @@
+/***************************************************************
+# packedgrid.cpp
+# Code implementing the PackedGrid, row, column and diagonal copies of a grid
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of PackedGrid class
+# 2026.10.2    15.10.2026   Single cell updates through all four copies
+# 2026.10.3    16.10.2026   Direction and letter code tables come from directions.h
+****************************************************************/
+
+#include "packedgrid.h"
+#include <algorithm>
+
+using namespace std;
+
+// Directions in gridDx/gridDy order: up-left, up, up-right, right, down-right, down, down-left, left
+const unsigned char PackedGrid::familyOf[8] = {Diagonals, Columns, AntiDiagonals, Rows, Diagonals, Columns, AntiDiagonals, Rows};
+const int PackedGrid::stepOf[8] = {-1, -1, -1, 1, 1, 1, 1, -1};
+
+// Cells per side of the tiles the copies are filled in, so the column and diagonal
+// writes of a tile stay within a few cache lines per line
+static const int tileSize = 64;
+
+// Constructor, an empty grid
+PackedGrid::PackedGrid()
+    : rowCount(0), colCount(0)
+{
+    for (auto& lineOffsets : offsets)
+    {
+        lineOffsets.assign(1, 0);
+    }
+}
+
+// Bytes held by the codes and line offsets of all four copies
+size_t PackedGrid::bytes() const
+{
+    size_t total = 0;
+    for (int f = 0; f < 4; f++)
+    {
+        total += codes[f].capacity() + offsets[f].capacity() * sizeof(size_t);
+    }
+    return total;
+}
+
+// Grid cell at a position along a line, the inverse of locate
+void PackedGrid::cellAt(Family family, int line, int position, int& row, int& col) const
+{
+    switch (family)
+    {
+    case Rows:
+        row = line;
+        col = position;
+        break;
+    case Columns:
+        row = position;
+        col = line;
+        break;
+    case Diagonals:
+        row = max(0, rowCount - 1 - line) + position;
+        col = max(0, line - (rowCount - 1)) + position;
+        break;
+    default:
+        row = max(0, line - (colCount - 1)) + position;
+        col = min(line, colCount - 1) - position;
+        break;
+    }
+}
+
+// Build the row, column, diagonal and anti-diagonal copies in one tiled pass over the grid
+void PackedGrid::build(const vector<vector<char>>& grid)
+{
+    rowCount = static_cast<int>(grid.size());
+    size_t width = grid.empty() ? 0 : grid[0].size();
+    for (const auto& row : grid)
+    {
+        width = min(width, row.size());  // Never step past the shortest row
+    }
+    colCount = rowCount > 0 ? static_cast<int>(width) : 0;
+
+    // Line lengths of each family give the offsets; every family holds rows * cols codes
+    int diagonalCount = rowCount > 0 && colCount > 0 ? rowCount + colCount - 1 : 0;
+    int lineCounts[4] = {rowCount, colCount, diagonalCount, diagonalCount};
+    for (int f = 0; f < 4; f++)
+    {
+        offsets[f].resize(lineCounts[f] + 1);
+        offsets[f][0] = 0;
+        for (int l = 0; l < lineCounts[f]; l++)
+        {
+            int length;
+            if (f == Rows) length = colCount;
+            else if (f == Columns) length = rowCount;
+            else if (f == Diagonals) length = min(rowCount - max(0, rowCount - 1 - l), colCount - max(0, l - (rowCount - 1)));
+            else length = min(rowCount - max(0, l - (colCount - 1)), min(l, colCount - 1) + 1);
+            offsets[f][l + 1] = offsets[f][l] + length;
+        }
+        codes[f].resize(offsets[f][lineCounts[f]]);
+    }
+
+    unsigned char* byRow = codes[Rows].data();
+    unsigned char* byColumn = codes[Columns].data();
+    unsigned char* byDiagonal = codes[Diagonals].data();
+    unsigned char* byAntiDiagonal = codes[AntiDiagonals].data();
+    const size_t* diagonalStart = offsets[Diagonals].data();
+    const size_t* antiDiagonalStart = offsets[AntiDiagonals].data();
+
+    for (int rowTile = 0; rowTile < rowCount; rowTile += tileSize)
+    {
+        int rowEnd = min(rowCount, rowTile + tileSize);
+        for (int colTile = 0; colTile < colCount; colTile += tileSize)
+        {
+            int colEnd = min(colCount, colTile + tileSize);
+            for (int r = rowTile; r < rowEnd; r++)
+            {
+                const char* source = grid[r].data();
+                for (int c = colTile; c < colEnd; c++)
+                {
+                    unsigned char code = letterCodes[static_cast<unsigned char>(source[c])];
+                    byRow[static_cast<size_t>(r) * colCount + c] = code;
+                    byColumn[static_cast<size_t>(c) * rowCount + r] = code;
+                    byDiagonal[diagonalStart[c - r + rowCount - 1] + min(r, c)] = code;
+                    int s = r + c;
+                    byAntiDiagonal[antiDiagonalStart[s] + (s < colCount ? r : r - (s - colCount + 1))] = code;
+                }
+            }
+        }
+    }
+}
+
+// Code of a grid character, the same mapping build uses
+unsigned char PackedGrid::codeOf(char c)
+{
+    return letterCodes[static_cast<unsigned char>(c)];
+}
+
+// Change one cell; its code sits at one position of one line in each family
+void PackedGrid::setCell(int row, int col, char c)
+{
+    unsigned char code = codeOf(c);
+    for (int f = 0; f < 4; f++)
+    {
+        int line;
+        int position;
+        locate(static_cast<Family>(f), row, col, line, position);
+        codes[f][offsets[f][line] + position] = code;
+    }
+}
@@ -0,0 +1,91 @@
+/***************************************************************
+# packedgrid.h
+# Header for packedgrid.cpp, defines the direction-major PackedGrid
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of PackedGrid class
+# 2026.10.2    15.10.2026   Added setCell and cell for grids edited in place
+# 2026.10.3    16.10.2026   notLetter is the shared notLetterCode from directions.h
+****************************************************************/
+
+#ifndef PACKEDGRID_H
+#define PACKEDGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "directions.h"
+
+// PackedGrid class definition.
+// The grid as one-byte letter codes (0-25 for A-Z, notLetter for anything else),
+// stored four times over in contiguous buffers: by rows, by columns, along the
+// down-right diagonals and along the down-left anti-diagonals. Each of the 8
+// search directions walks one of these line families forwards or backwards, so
+// every direction reads memory with unit stride instead of jumping between rows.
+//
+// Lines are numbered the same way as the Aho-Corasick engine streams them:
+//   Rows           line r is row r, left to right
+//   Columns        line c is column c, top to bottom
+//   Diagonals      line k starts at row max(0, rows-1-k), col max(0, k-(rows-1)), runs down-right
+//   AntiDiagonals  line s holds the cells with row + col == s, top to bottom
+class PackedGrid
+{
+public:
+    enum Family { Rows = 0, Columns = 1, Diagonals = 2, AntiDiagonals = 3 };
+
+    static const unsigned char notLetter = notLetterCode;  // Code of a cell no word can pass through
+
+    PackedGrid();
+
+    // Rebuild all four copies from grid, as wide as its shortest row. Buffers are reused.
+    void build(const std::vector<std::vector<char>>& grid);
+
+    int rows() const { return rowCount; }
+    int cols() const { return colCount; }
+    size_t bytes() const;  // Bytes held by the codes and line offsets
+
+    int lineCount(Family family) const { return static_cast<int>(offsets[family].size()) - 1; }
+    int lineLength(Family family, int line) const { return static_cast<int>(offsets[family][line + 1] - offsets[family][line]); }
+    const unsigned char* line(Family family, int line) const { return codes[family].data() + offsets[family][line]; }
+
+    // Line holding cell (row, col) in a family and the cell's position along it
+    void locate(Family family, int row, int col, int& line, int& position) const
+    {
+        switch (family)
+        {
+        case Rows: line = row; position = col; break;
+        case Columns: line = col; position = row; break;
+        case Diagonals: line = col - row + rowCount - 1; position = row < col ? row : col; break;
+        default: line = row + col; position = line < colCount ? row : row - (line - colCount + 1); break;
+        }
+    }
+
+    // Grid cell at a position along a line
+    void cellAt(Family family, int line, int position, int& row, int& col) const;
+
+    // Code of cell (row, col), and a change to it written through all four copies
+    unsigned char cell(int row, int col) const { return codes[Rows][static_cast<size_t>(row) * colCount + col]; }
+    void setCell(int row, int col, char c);
+
+    // Code of a grid character, 0-25 for A-Z in either case and notLetter for anything else
+    static unsigned char codeOf(char c);
+
+    // Family walked by direction d (0-7, in gridDx/gridDy order) and its step along the line, +1 or -1
+    static Family directionFamily(int d) { return static_cast<Family>(familyOf[d]); }
+    static int directionStep(int d) { return stepOf[d]; }
+
+private:
+    static const unsigned char familyOf[8];
+    static const int stepOf[8];
+
+    int rowCount;
+    int colCount;
+    std::vector<unsigned char> codes[4];  // Letter codes of every line of each family, line after line
+    std::vector<size_t> offsets[4];       // Start of each line in codes, plus the total at the end
+};
+
+#endif // PACKEDGRID_H
@@ -0,0 +1,351 @@
+/***************************************************************
+# resultwriter.cpp
+# Code implementing the buffered ResultWriter and its output formats
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    16.10.2026   Initial implementation of ResultWriter with text, JSON, CSV and binary formats
+# 2026.10.2    16.10.2026   Hit end cells use the shared gridDx/gridDy
+# 2026.10.3    16.10.2026   One JSON string escaper, appendJSONString, shared with batch records
+# 2026.10.4    16.10.2026   Binary header and records stored byte by byte in little-endian order
+****************************************************************/
+
+#include "resultwriter.h"
+#include "directions.h"
+#include <cstring>  // For memcpy and strlen
+
+using namespace std;
+
+const size_t ResultWriter::defaultBufferBytes;
+
+// Look up a format by its command-line name
+bool parseOutputFormat(const string& name, OutputFormat& format)
+{
+    if (name == "text") format = OutputFormat::Text;
+    else if (name == "json") format = OutputFormat::Json;
+    else if (name == "csv") format = OutputFormat::Csv;
+    else if (name == "bin") format = OutputFormat::Bin;
+    else return false;
+    return true;
+}
+
+// Command-line name of a format
+const char* outputFormatName(OutputFormat format)
+{
+    switch (format)
+    {
+    case OutputFormat::Json: return "json";
+    case OutputFormat::Csv: return "csv";
+    case OutputFormat::Bin: return "bin";
+    default: return "text";
+    }
+}
+
+// Store the low bytes of value at out, least significant first, as the binary format is little-endian
+static void storeLittleEndian(char* out, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+// Append text to out as a JSON string, quotes included
+void appendJSONString(string& out, const char* text, size_t length)
+{
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += static_cast<char>(c);
+        }
+        else if (c < 0x20)
+        {
+            out += "\\u00";
+            out += hex[c >> 4];
+            out += hex[c & 15];
+        }
+        else
+        {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+ResultWriter::ResultWriter(ostream& out, OutputFormat format, size_t bufferBytes)
+    : out(out), format(format), capacity(bufferBytes > 0 ? bufferBytes : 1), written(0), withMismatches(false), index(0)
+{
+    buffer.reserve(capacity);
+}
+
+ResultWriter::~ResultWriter()
+{
+    flush();
+}
+
+// Write first-occurrence results, with their mismatch counts when given
+void ResultWriter::write(const vector<pair<string, pair<pair<int, int>, pair<int, int>>>>& locations, const vector<int>& mismatches)
+{
+    size_t textBytes = 0;
+    for (const auto& entry : locations)
+    {
+        textBytes += entry.first.size();
+    }
+
+    begin(locations.size(), textBytes, !mismatches.empty());
+    uint32_t offset = 0;
+    for (size_t k = 0; k < locations.size(); k++)
+    {
+        const auto& entry = locations[k];
+        add(entry.first.data(), entry.first.size(), offset, entry.second.first.first, entry.second.first.second,
+            entry.second.second.first, entry.second.second.second, mismatches.empty() ? 0 : mismatches[k]);
+        offset += static_cast<uint32_t>(entry.first.size());
+    }
+
+    // The binary letters section follows the records, in the same order
+    if (format == OutputFormat::Bin)
+    {
+        for (const auto& entry : locations)
+        {
+            append(entry.first);
+        }
+    }
+    end();
+}
+
+// Write every occurrence of an all-occurrences search
+void ResultWriter::write(const SearchResults& results)
+{
+    // Every word's letters are stored once in the table; records point into them
+    const WordTable& words = results.words;
+    size_t textBytes = words.size() == 0 ? 0 : (words.data(static_cast<uint32_t>(words.size() - 1)) - words.data(0)) + words.length(static_cast<uint32_t>(words.size() - 1));
+
+    begin(results.hits.size(), textBytes, false);
+    for (const auto& hit : results.hits)
+    {
+        // Hits are 0-based with a direction; report them like the first-occurrence results
+        int endX = hit.row + (hit.length - 1) * gridDx[hit.dir];
+        int endY = hit.col + (hit.length - 1) * gridDy[hit.dir];
+        const char* word = words.data(hit.wordId);
+        add(word, words.length(hit.wordId), static_cast<uint32_t>(word - words.data(0)), hit.row + 1, hit.col + 1, endX + 1, endY + 1, 0);
+    }
+    if (format == OutputFormat::Bin && textBytes > 0)
+    {
+        append(words.data(0), textBytes);
+    }
+    end();
+}
+
+// Hand the buffered bytes to the stream and flush it
+void ResultWriter::flush()
+{
+    drain();
+    out.flush();
+}
+
+// Start a document of count words holding textBytes letters
+void ResultWriter::begin(size_t count, size_t textBytes, bool mismatchCounts)
+{
+    withMismatches = mismatchCounts;
+    index = 0;
+    switch (format)
+    {
+    case OutputFormat::Text:
+        append("Found words and their locations: \n", 34);
+        break;
+    case OutputFormat::Json:
+        append("{\"found\": ", 10);
+        appendNumber(static_cast<long long>(count));
+        append(", \"words\": [", 12);
+        break;
+    case OutputFormat::Csv:
+        append(withMismatches ? "word,start_row,start_col,end_row,end_col,mismatches\n" : "word,start_row,start_col,end_row,end_col\n");
+        break;
+    case OutputFormat::Bin:
+    {
+        char header[sizeof(ResultFileHeader)];
+        memcpy(header + offsetof(ResultFileHeader, magic), resultFileMagic, sizeof(resultFileMagic));
+        storeLittleEndian(header + offsetof(ResultFileHeader, version), resultFileVersion, 4);
+        storeLittleEndian(header + offsetof(ResultFileHeader, recordBytes), sizeof(ResultRecord), 4);
+        storeLittleEndian(header + offsetof(ResultFileHeader, flags), withMismatches ? resultHasMismatches : 0, 4);
+        storeLittleEndian(header + offsetof(ResultFileHeader, records), count, 8);
+        storeLittleEndian(header + offsetof(ResultFileHeader, textBytes), textBytes, 8);
+        append(header, sizeof(header));
+        break;
+    }
+    }
+}
+
+// Close the current document
+void ResultWriter::end()
+{
+    if (format == OutputFormat::Json)
+    {
+        append(index > 0 ? "\n]}\n" : "]}\n");
+    }
+}
+
+// Append one word in the current format
+void ResultWriter::add(const char* word, size_t length, uint32_t textOffset, int startRow, int startCol, int endRow, int endCol, int mismatches)
+{
+    switch (format)
+    {
+    case OutputFormat::Text:
+        append("Word: ", 6);
+        append(word, length);
+        append(" from position (", 16);
+        appendNumber(startRow);
+        append(", ", 2);
+        appendNumber(startCol);
+        append(") to position (", 15);
+        appendNumber(endRow);
+        append(", ", 2);
+        appendNumber(endCol);
+        append(")", 1);
+        if (withMismatches)
+        {
+            append(" with ", 6);
+            appendNumber(mismatches);
+            append(mismatches == 1 ? " mismatch" : " mismatches");
+        }
+        append("\n", 1);
+        break;
+    case OutputFormat::Json:
+        append(index > 0 ? ",\n{\"word\": " : "\n{\"word\": ");
+        appendJSONString(word, length);
+        append(", \"start\": [", 12);
+        appendNumber(startRow);
+        append(", ", 2);
+        appendNumber(startCol);
+        append("], \"end\": [", 11);
+        appendNumber(endRow);
+        append(", ", 2);
+        appendNumber(endCol);
+        append("]", 1);
+        if (withMismatches)
+        {
+            append(", \"mismatches\": ", 16);
+            appendNumber(mismatches);
+        }
+        append("}", 1);
+        break;
+    case OutputFormat::Csv:
+        appendCSVField(word, length);
+        append(",", 1);
+        appendNumber(startRow);
+        append(",", 1);
+        appendNumber(startCol);
+        append(",", 1);
+        appendNumber(endRow);
+        append(",", 1);
+        appendNumber(endCol);
+        if (withMismatches)
+        {
+            append(",", 1);
+            appendNumber(mismatches);
+        }
+        append("\n", 1);
+        break;
+    case OutputFormat::Bin:
+    {
+        char record[sizeof(ResultRecord)];
+        storeLittleEndian(record + offsetof(ResultRecord, textOffset), textOffset, 4);
+        storeLittleEndian(record + offsetof(ResultRecord, length), static_cast<uint32_t>(length), 4);
+        storeLittleEndian(record + offsetof(ResultRecord, startRow), static_cast<uint32_t>(startRow), 4);
+        storeLittleEndian(record + offsetof(ResultRecord, startCol), static_cast<uint32_t>(startCol), 4);
+        storeLittleEndian(record + offsetof(ResultRecord, endRow), static_cast<uint32_t>(endRow), 4);
+        storeLittleEndian(record + offsetof(ResultRecord, endCol), static_cast<uint32_t>(endCol), 4);
+        storeLittleEndian(record + offsetof(ResultRecord, mismatches), static_cast<uint32_t>(mismatches), 4);
+        append(record, sizeof(record));
+        break;
+    }
+    }
+    index++;
+}
+
+// Append raw bytes, draining the buffer first when they would overflow it
+void ResultWriter::append(const char* data, size_t length)
+{
+    if (buffer.size() + length > capacity)
+    {
+        drain();
+        if (length >= capacity)
+        {
+            // Too big to be worth copying; goes straight to the stream
+            out.write(data, static_cast<streamsize>(length));
+            written += length;
+            return;
+        }
+    }
+    buffer.append(data, length);
+}
+
+// Append a decimal number without going through a stream or to_string
+void ResultWriter::appendNumber(long long value)
+{
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* p = end;
+    unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+    do
+    {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0)
+    {
+        *--p = '-';
+    }
+    append(p, static_cast<size_t>(end - p));
+}
+
+// Append a CSV field, quoted only when it holds a comma, quote or line break
+void ResultWriter::appendCSVField(const char* text, size_t length)
+{
+    bool quote = false;
+    for (size_t i = 0; i < length && !quote; i++)
+    {
+        quote = text[i] == ',' || text[i] == '"' || text[i] == '\n' || text[i] == '\r';
+    }
+    if (!quote)
+    {
+        append(text, length);
+        return;
+    }
+    append("\"", 1);
+    for (size_t i = 0; i < length; i++)
+    {
+        append(text[i] == '"' ? "\"\"" : &text[i], text[i] == '"' ? 2 : 1);
+    }
+    append("\"", 1);
+}
+
+// Append text as a JSON string, quotes included, straight into the buffer
+void ResultWriter::appendJSONString(const char* text, size_t length)
+{
+    // An escaped byte takes at most 6 bytes; drain first unless the longest escape fits
+    if (buffer.size() + length * 6 + 2 > capacity)
+    {
+        drain();
+    }
+    ::appendJSONString(buffer, text, length);
+}
+
+// Hand the buffered bytes to the stream without flushing it
+void ResultWriter::drain()
+{
+    if (!buffer.empty())
+    {
+        out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+        written += buffer.size();
+        buffer.clear();
+    }
+}
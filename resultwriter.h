@@ -0,0 +1,132 @@
+/***************************************************************
+# resultwriter.h
+# Header for resultwriter.cpp, defines the buffered ResultWriter and its output formats
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    16.10.2026   Initial implementation of ResultWriter with text, JSON, CSV and binary formats
+# 2026.10.2    16.10.2026   Declared appendJSONString, the JSON string escaper batch records share
+# 2026.10.3    16.10.2026   static_assert on the 32-byte header and 28-byte record
+****************************************************************/
+
+#ifndef RESULTWRITER_H
+#define RESULTWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "wordtable.h"
+
+// Output formats of a ResultWriter
+enum class OutputFormat
+{
+    Text,  // "Word: X from position (r, c) to position (r, c)" lines, as GridLex has always printed
+    Json,  // One JSON object with a found count and a words array
+    Csv,   // A header line, then one line per word
+    Bin    // A ResultFileHeader, fixed-width ResultRecords, then the words' letters
+};
+
+// Look up a format by its command-line name (text, json, csv or bin), returns false for an unknown name
+bool parseOutputFormat(const std::string& name, OutputFormat& format);
+
+// Command-line name of a format
+const char* outputFormatName(OutputFormat format);
+
+// Append text to out as a JSON string, quotes included, escaping quotes, backslashes and control bytes.
+// The one escaper behind the json format and the batch and server records.
+void appendJSONString(std::string& out, const char* text, size_t length);
+
+// Binary output layout, little-endian with no padding:
+//   ResultFileHeader                  32 bytes
+//   ResultRecord x header.records     28 bytes each
+//   letters                           header.textBytes bytes
+// The writer stores every field byte by byte, so the file is little-endian on any host.
+// A loader on a little-endian host can map the file and index the records directly;
+// a record's word is the length letters at textOffset from the start of the letters.
+static const char resultFileMagic[4] = {'G', 'L', 'X', 'R'};
+static const uint32_t resultFileVersion = 1;
+static const uint32_t resultHasMismatches = 1;  // header.flags bit: the records' mismatch counts were filled in by -k
+
+struct ResultFileHeader
+{
+    char magic[4];         // "GLXR"
+    uint32_t version;      // resultFileVersion
+    uint32_t recordBytes;  // sizeof(ResultRecord), so a newer reader can skip fields it does not know
+    uint32_t flags;        // resultHasMismatches or 0
+    uint64_t records;      // Number of records
+    uint64_t textBytes;    // Size of the letters section
+};
+static_assert(sizeof(ResultFileHeader) == 32, "ResultFileHeader must be 32 bytes with no padding");
+
+// One found word; positions are 1-based, as in the text output
+struct ResultRecord
+{
+    uint32_t textOffset;  // Word letters in the letters section
+    uint32_t length;      // Letters in the word
+    int32_t startRow;
+    int32_t startCol;
+    int32_t endRow;
+    int32_t endCol;
+    int32_t mismatches;   // Grid letters that differ from the word, 0 without -k
+};
+static_assert(sizeof(ResultRecord) == 28, "ResultRecord must be 28 bytes with no padding");
+
+// ResultWriter class definition.
+// Formats search results into one large buffer and hands it to the stream in
+// big writes, instead of flushing the stream after every line. Each write call
+// produces a whole document in the chosen format; the buffer is drained by
+// flush() and by the destructor.
+class ResultWriter
+{
+public:
+    static const size_t defaultBufferBytes = 1 << 20;
+
+    ResultWriter(std::ostream& out, OutputFormat format, size_t bufferBytes = defaultBufferBytes);
+    ~ResultWriter();
+
+    // Write first-occurrence results. mismatches is empty, or holds the -k mismatch count of each entry.
+    void write(const std::vector<std::pair<std::string, std::pair<std::pair<int, int>, std::pair<int, int>>>>& locations, const std::vector<int>& mismatches);
+
+    // Write every occurrence of an all-occurrences search, in its hit order
+    void write(const SearchResults& results);
+
+    // Hand the buffered bytes to the stream and flush it
+    void flush();
+
+    size_t bytesWritten() const { return written + buffer.size(); }  // Bytes produced so far
+
+private:
+    // Document framing around count records of words holding textBytes letters in all
+    void begin(size_t count, size_t textBytes, bool mismatchCounts);
+    void end();
+
+    // Append one word in the current format. textOffset is only used by the binary format.
+    void add(const char* word, size_t length, uint32_t textOffset, int startRow, int startCol, int endRow, int endCol, int mismatches);
+
+    // Append raw bytes, draining the buffer first when they would overflow it
+    void append(const char* data, size_t length);
+    void append(const char* text) { append(text, std::strlen(text)); }
+    void append(const std::string& text) { append(text.data(), text.size()); }
+    void appendNumber(long long value);
+    void appendCSVField(const char* text, size_t length);
+    void appendJSONString(const char* text, size_t length);
+
+    void drain();  // Hand the buffered bytes to the stream without flushing it
+
+    std::ostream& out;
+    OutputFormat format;
+    size_t capacity;  // Buffer size that triggers a write to the stream
+    std::string buffer;  // Bytes not yet handed to the stream
+    size_t written;  // Bytes already handed to the stream
+    bool withMismatches;  // The document being written reports mismatch counts
+    size_t index;  // Records added to the current document
+};
+
+#endif // RESULTWRITER_H
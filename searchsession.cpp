@@ -0,0 +1,210 @@
+/***************************************************************
+# searchsession.cpp
+# Code implementing the incremental SearchSession for grids edited a cell at a time
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of SearchSession class
+****************************************************************/
+
+#include "searchsession.h"
+#include <algorithm>
+
+using namespace std;
+
+// Constructor, an empty grid with no words
+SearchSession::SearchSession(const FlatTrie& trie, int minWordLength)
+    : trie(trie), minWordLength(minWordLength), reach(0), presentWords(0), occurrences(0)
+{
+    size_t longest = trie.maxWordLength();
+    reach = longest > 0 ? static_cast<int>(longest) - 1 : 0;
+    counts.assign(trie.nodeCount(), 0);
+    names.reset(trie.nodeCount());
+}
+
+// Search the whole grid, one line at a time
+void SearchSession::load(const vector<vector<char>>& cells)
+{
+    grid.build(cells);
+    counts.assign(trie.nodeCount(), 0);
+    names.reset(trie.nodeCount());
+    presentWords = 0;
+    occurrences = 0;
+
+    for (int f = 0; f < 4; f++)
+    {
+        PackedGrid::Family family = static_cast<PackedGrid::Family>(f);
+        lineHits[f].assign(grid.lineCount(family), vector<LineHit>());
+        for (int line = 0; line < grid.lineCount(family); line++)
+        {
+            scanLine(family, line, -1, nullptr);
+        }
+    }
+}
+
+// Count one more occurrence of a word
+void SearchSession::addOccurrence(const LineHit& hit, const unsigned char* codes)
+{
+    if (counts[hit.node]++ == 0)
+    {
+        presentWords++;
+        if (names.find(hit.node) == WordTable::npos)
+        {
+            string word;
+            for (int k = 0; k < hit.length; k++)
+            {
+                word += static_cast<char>('A' + codes[hit.start + k * hit.step]);
+            }
+            names.add(hit.node, word.data(), word.size());
+        }
+    }
+    occurrences++;
+}
+
+// Walk the trie from each start position of a line, forwards and backwards
+void SearchSession::scanLine(PackedGrid::Family family, int line, int position, map<uint32_t, int>* delta)
+{
+    const unsigned char* codes = grid.line(family, line);
+    int length = grid.lineLength(family, line);
+    vector<LineHit>& hits = lineHits[family][line];
+
+    for (int step = 1; step >= -1; step -= 2)
+    {
+        // A word through position starts at most reach cells before it, in walking order
+        int first = 0;
+        int last = length - 1;
+        if (position >= 0)
+        {
+            first = step > 0 ? max(0, position - reach) : position;
+            last = step > 0 ? position : min(length - 1, position + reach);
+        }
+
+        for (int start = first; start <= last; start++)
+        {
+            uint32_t node = trie.root();
+            for (int k = start, len = 1; k >= 0 && k < length; k += step, len++)
+            {
+                if (codes[k] >= 26 || (node = trie.child(node, codes[k])) == 0)
+                {
+                    break;  // Not a letter, or no further path in the trie
+                }
+                if (!trie.isEndOfWord(node) || len < minWordLength || trie.isIgnored(node))
+                {
+                    continue;
+                }
+                if (position >= 0 && (step > 0 ? k < position : k > position))
+                {
+                    continue;  // Ends before the edited cell, so it was kept
+                }
+
+                LineHit hit = {node, start, step, len};
+                hits.push_back(hit);
+                addOccurrence(hit, codes);
+                if (delta) (*delta)[node]++;
+            }
+        }
+    }
+}
+
+// Replace the occurrences through one cell with those its new letter makes
+bool SearchSession::setCell(int row, int col, char c, vector<string>& added, vector<string>& removed)
+{
+    added.clear();
+    removed.clear();
+    if (row < 0 || row >= grid.rows() || col < 0 || col >= grid.cols())
+    {
+        return false;
+    }
+    if (grid.cell(row, col) == PackedGrid::codeOf(c))
+    {
+        return true;  // Same letter, nothing can change
+    }
+
+    // Drop every occurrence through the cell, on each of the 4 lines that cross it
+    map<uint32_t, int> delta;
+    int lines[4];
+    int positions[4];
+    for (int f = 0; f < 4; f++)
+    {
+        grid.locate(static_cast<PackedGrid::Family>(f), row, col, lines[f], positions[f]);
+        vector<LineHit>& hits = lineHits[f][lines[f]];
+        int position = positions[f];
+        auto through = [position](const LineHit& hit)
+        {
+            int end = hit.start + (hit.length - 1) * hit.step;
+            return min(hit.start, end) <= position && position <= max(hit.start, end);
+        };
+
+        for (const auto& hit : hits)
+        {
+            if (through(hit))
+            {
+                delta[hit.node]--;
+                occurrences--;
+                if (--counts[hit.node] == 0)
+                {
+                    presentWords--;
+                }
+            }
+        }
+        hits.erase(remove_if(hits.begin(), hits.end(), through), hits.end());
+    }
+
+    grid.setCell(row, col, c);
+    for (int f = 0; f < 4; f++)
+    {
+        scanLine(static_cast<PackedGrid::Family>(f), lines[f], positions[f], &delta);
+    }
+
+    // A word appeared or disappeared when its count moved to or from zero
+    for (const auto& change : delta)
+    {
+        uint32_t count = counts[change.first];
+        uint32_t before = static_cast<uint32_t>(static_cast<int64_t>(count) - change.second);
+        if (before == 0 && count > 0)
+        {
+            added.push_back(names.word(names.find(change.first)));
+        }
+        else if (before > 0 && count == 0)
+        {
+            removed.push_back(names.word(names.find(change.first)));
+        }
+    }
+    sort(added.begin(), added.end());
+    sort(removed.begin(), removed.end());
+    return true;
+}
+
+// Every word with at least one occurrence
+vector<string> SearchSession::words() const
+{
+    vector<string> present;
+    present.reserve(presentWords);
+    for (uint32_t node = 0; node < counts.size(); node++)
+    {
+        if (counts[node] > 0)
+        {
+            present.push_back(names.word(names.find(node)));
+        }
+    }
+    sort(present.begin(), present.end());
+    return present;
+}
+
+// Follow the word through the trie and check its node's count
+bool SearchSession::contains(const string& word) const
+{
+    uint32_t node = trie.root();
+    for (char c : word)
+    {
+        unsigned char code = PackedGrid::codeOf(c);
+        if (code >= 26 || (node = trie.child(node, code)) == 0)
+        {
+            return false;
+        }
+    }
+    return node != trie.root() && counts[node] > 0;
+}
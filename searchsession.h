@@ -0,0 +1,88 @@
+/***************************************************************
+# searchsession.h
+# Header for searchsession.cpp, defines the incremental SearchSession
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of SearchSession class
+****************************************************************/
+
+#ifndef SEARCHSESSION_H
+#define SEARCHSESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "flattrie.h"
+#include "packedgrid.h"
+#include "wordtable.h"
+
+// SearchSession class definition.
+// Keeps a grid and every occurrence of every word in it, for an editor that
+// changes one cell at a time. Each occurrence lies along exactly one row,
+// column or diagonal, so occurrences are stored per PackedGrid line. An edit
+// only touches the occurrences that pass through the edited cell, and they all
+// lie on the 4 lines through it. setCell drops those, rescans the stretch of
+// each line within one word length of the cell, and reports the words whose
+// occurrence count went to or from zero. An edit costs time in proportion to
+// the line length, not the grid area.
+//
+// Ignore marks (FlatTrie::markIgnored) and minWordLength filter words as in
+// the search engines. Words are reported in upper case. The trie must outlive
+// the session and must not change while the session uses it.
+class SearchSession
+{
+public:
+    SearchSession(const FlatTrie& trie, int minWordLength);
+
+    // Search a new grid in full, as wide as its shortest row. Any earlier grid is forgotten.
+    void load(const std::vector<std::vector<char>>& grid);
+
+    // Set cell (row, col), 0-based, to c and update the words found. added and removed
+    // receive, in alphabetical order, the words that appeared and disappeared.
+    // Returns false, changing nothing, if the cell is outside the grid.
+    bool setCell(int row, int col, char c, std::vector<std::string>& added, std::vector<std::string>& removed);
+
+    std::vector<std::string> words() const;  // Words currently in the grid, in alphabetical order
+    bool contains(const std::string& word) const;  // Whether a word is currently in the grid, any case
+    size_t wordCount() const { return presentWords; }  // Distinct words currently in the grid
+    size_t occurrenceCount() const { return occurrences; }  // Occurrences of all words, each direction counted
+
+    int rows() const { return grid.rows(); }
+    int cols() const { return grid.cols(); }
+
+private:
+    // One occurrence along a line: its end-of-word node, start position, step (+1 or -1) and length
+    struct LineHit
+    {
+        uint32_t node;
+        int32_t start;
+        int32_t step;
+        int32_t length;
+    };
+
+    // Scan a line in both directions and record the occurrences found. With position < 0
+    // the whole line is scanned; otherwise only occurrences passing through that position.
+    // Changes in occurrence count per node are added to delta when it is given.
+    void scanLine(PackedGrid::Family family, int line, int position, std::map<uint32_t, int>* delta);
+
+    // Count one more occurrence of a word, interning its text the first time it is seen
+    void addOccurrence(const LineHit& hit, const unsigned char* codes);
+
+    const FlatTrie& trie;
+    int minWordLength;
+    int reach;  // Cells a word can extend past its first one, the longest word length less one
+    PackedGrid grid;  // The grid as letter codes, one copy per line family
+    std::vector<std::vector<LineHit>> lineHits[4];  // Occurrences on each line of each family
+    std::vector<uint32_t> counts;  // Occurrences of each end-of-word node
+    WordTable names;  // Text of every word seen, keyed by node
+    size_t presentWords;
+    size_t occurrences;
+};
+
+#endif // SEARCHSESSION_H
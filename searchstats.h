@@ -0,0 +1,52 @@
+/***************************************************************
+# searchstats.h
+# Defines the SearchStats counters filled in by the search engines
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial version of SearchStats
+# 2026.10.2    15.10.2026   Added walksSkipped for start cells dropped by the bigram prefilter
+# 2026.10.3    15.10.2026   Added exhaustedPrunes for branches the boggle engine had nothing left to find in
+****************************************************************/
+
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <cstdint>
+
+// SearchStats structure, counters collected during a search.
+// Engines only count when handed a SearchStats; without one they run a
+// separately compiled copy of their inner loop with the counting removed.
+struct SearchStats
+{
+    uint64_t walksStarted = 0;       // Straight-line walks begun (lines streamed for the ac engine)
+    uint64_t walksSkipped = 0;       // Walks the bigram prefilter showed would match at most one letter
+    uint64_t trieSteps = 0;          // Trie edges followed (characters streamed for the ac engine)
+    uint64_t prunedAtDepthOne = 0;   // Walks that ended having matched at most one letter
+    uint64_t hits = 0;               // End-of-word nodes reached
+    uint64_t accepted = 0;           // Hits reported as found words
+    uint64_t rejectedMinLength = 0;  // Hits shorter than the minimum word length
+    uint64_t rejectedDuplicate = 0;  // Hits of a word that was already reported
+    uint64_t rejectedIgnored = 0;    // Hits of a word in the ignore list
+    uint64_t exhaustedPrunes = 0;    // Branches not walked because every word below was already reported
+
+    // Add another set of counters, used to combine per-thread counters
+    void add(const SearchStats& other)
+    {
+        walksStarted += other.walksStarted;
+        walksSkipped += other.walksSkipped;
+        trieSteps += other.trieSteps;
+        prunedAtDepthOne += other.prunedAtDepthOne;
+        hits += other.hits;
+        accepted += other.accepted;
+        rejectedMinLength += other.rejectedMinLength;
+        rejectedDuplicate += other.rejectedDuplicate;
+        rejectedIgnored += other.rejectedIgnored;
+        exhaustedPrunes += other.exhaustedPrunes;
+    }
+};
+
+#endif // SEARCHSTATS_H
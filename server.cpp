@@ -0,0 +1,320 @@
+/***************************************************************
+# server.cpp
+# Code implementing the GridServer, grid searches over a Unix domain socket
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of GridServer class
+# 2026.10.2    16.10.2026   Oversized lines and grids rejected, ragged grids counted as errors
+****************************************************************/
+
+#include "server.h"
+#include "csvreader.h"
+#include "unixsocket.h"
+#include <algorithm>
+#include <cctype>
+#include <csignal>
+#include <iostream>
+#include <thread>
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Number of recent requests the latency percentiles are taken over
+static const size_t latencyWindow = 65536;
+
+// Set from the signal handler to stop the accept loop
+static volatile sig_atomic_t stopRequested = 0;
+
+static void handleStopSignal(int)
+{
+    stopRequested = 1;
+}
+
+// Value at quantile q (0 to 1) of a sorted sample, nearest rank
+static double sortedQuantile(const vector<double>& sorted, double q)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(q * sorted.size() + 0.999999);
+    rank = min(max(rank, static_cast<size_t>(1)), sorted.size());
+    return sorted[rank - 1];
+}
+
+// Constructor, the dictionary and engines must stay loaded while the server runs
+GridServer::GridServer(const BatchConfig& config, Trie* trie, const FlatTrie* flatTrie, const AhoCorasick* automaton, const set<string>& ignoreWords)
+    : config(config), trie(trie), flatTrie(flatTrie), automaton(automaton), ignoreWords(ignoreWords),
+      stopping(false), nextIndex(0), latencyNext(0), requests(0), errors(0), connections(0), started(chrono::steady_clock::now())
+{
+}
+
+// Run queued searches with this thread's own engines and scratch
+void GridServer::workerLoop()
+{
+    SearchWorker worker;
+    for (;;)
+    {
+        Job* job;
+        uint64_t index;
+        {
+            unique_lock<mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty())
+            {
+                return;  // Stopping and nothing left to answer
+            }
+            job = queue.front();
+            queue.pop_front();
+            index = nextIndex++;
+        }
+
+        searchGridRecord(worker, config, trie, flatTrie, automaton, ignoreWords, index, job->name, job->grid);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - job->received).count();
+        {
+            lock_guard<mutex> lock(statsMutex);
+            requests++;
+            errors += gridError(job->grid) ? 1 : 0;  // Answered with an error record
+            if (latencies.size() < latencyWindow)
+            {
+                latencies.push_back(ms);
+            }
+            else
+            {
+                latencies[latencyNext] = ms;
+            }
+            latencyNext = (latencyNext + 1) % latencyWindow;
+        }
+        job->response.set_value(worker.record);
+    }
+}
+
+// JSON line with the request counters and latency percentiles over the recent window
+string GridServer::statsRecord()
+{
+    vector<double> sorted;
+    uint64_t answered, failed, accepted;
+    {
+        lock_guard<mutex> lock(statsMutex);
+        sorted = latencies;
+        answered = requests;
+        failed = errors;
+        accepted = connections;
+    }
+    sort(sorted.begin(), sorted.end());
+
+    size_t queued;
+    {
+        lock_guard<mutex> lock(queueMutex);
+        queued = queue.size();
+    }
+
+    double uptime = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    return "{\"requests\": " + to_string(answered) + ", \"errors\": " + to_string(failed) +
+           ", \"connections\": " + to_string(accepted) + ", \"workers\": " + to_string(max(1, config.threads)) +
+           ", \"queued\": " + to_string(queued) + ", \"uptime_s\": " + to_string(uptime) +
+           ", \"latency_ms\": {\"window\": " + to_string(sorted.size()) +
+           ", \"p50\": " + to_string(sortedQuantile(sorted, 0.5)) +
+           ", \"p90\": " + to_string(sortedQuantile(sorted, 0.9)) +
+           ", \"p99\": " + to_string(sortedQuantile(sorted, 0.99)) +
+           ", \"max\": " + to_string(sorted.empty() ? 0.0 : sorted.back()) + "}}\n";
+}
+
+// Answer one client's requests in order until it disconnects or sends QUIT
+void GridServer::serveConnection(int fd)
+{
+    SocketStream stream(fd);
+    string line;
+
+    while (stream.readLine(line, serverMaxLineBytes))
+    {
+        if (line.empty())
+        {
+            continue;  // Stray blank lines between requests are harmless
+        }
+
+        string response;
+        if (line == "QUIT")
+        {
+            break;
+        }
+        else if (line == "STATS")
+        {
+            response = statsRecord();
+        }
+        else if (line.compare(0, 6, "SEARCH") == 0 && (line.size() == 6 || isspace(static_cast<unsigned char>(line[6]))))
+        {
+            Job job;
+            size_t nameStart = line.find_first_not_of(" \t", 6);
+            job.name = nameStart == string::npos ? string() : line.substr(nameStart);
+
+            // Grid rows follow, up to an empty line. Rows past a limit are read and dropped,
+            // so the connection stays in step for the next request.
+            bool complete = false;
+            const char* tooBig = nullptr;
+            while (stream.readLine(line, serverMaxLineBytes))
+            {
+                if (line.empty())
+                {
+                    complete = true;
+                    break;
+                }
+                if (tooBig)
+                {
+                    continue;
+                }
+                vector<char> row;
+                CSVReader::parseCells(line.data(), line.data() + line.size(), row);
+                if (row.size() > serverMaxCols)
+                {
+                    tooBig = "grid has more columns than the server accepts";
+                }
+                else if (!row.empty() && job.grid.size() == serverMaxRows)
+                {
+                    tooBig = "grid has more rows than the server accepts";
+                }
+                else if (!row.empty())
+                {
+                    job.grid.push_back(move(row));
+                }
+            }
+            if (!complete)
+            {
+                break;  // Client went away in the middle of a grid, or sent an overlong row
+            }
+
+            if (tooBig)
+            {
+                job.grid.clear();
+                {
+                    lock_guard<mutex> lock(statsMutex);
+                    errors++;
+                }
+                response = string("{\"error\": \"") + tooBig + "\"}\n";
+            }
+            else
+            {
+                job.received = chrono::steady_clock::now();
+                future<string> answer = job.response.get_future();
+                {
+                    lock_guard<mutex> lock(queueMutex);
+                    queue.push_back(&job);
+                }
+                queueReady.notify_one();
+                response = answer.get();
+            }
+        }
+        else
+        {
+            {
+                lock_guard<mutex> lock(statsMutex);
+                errors++;
+            }
+            response = "{\"error\": \"unknown request, expected SEARCH, STATS or QUIT\"}\n";
+        }
+
+        if (!stream.writeAll(response))
+        {
+            break;
+        }
+    }
+
+    // A line past the limit leaves no way to find the next request; say why before closing
+    if (stream.lineTooLong())
+    {
+        {
+            lock_guard<mutex> lock(statsMutex);
+            errors++;
+        }
+        stream.writeAll("{\"error\": \"line longer than the server accepts, closing the connection\"}\n");
+    }
+
+    lock_guard<mutex> lock(connectionMutex);
+    openConnections.erase(fd);
+    connectionsDone.notify_all();
+}
+
+// Accept connections until a stop signal, then drain the workers and remove the socket
+bool GridServer::run(const string& socketPath)
+{
+#ifndef _WIN32
+    int listener = listenUnixSocket(socketPath);
+    if (listener < 0)
+    {
+        return false;
+    }
+
+    signal(SIGPIPE, SIG_IGN);  // A client closing early must not kill the server
+    stopRequested = 0;
+    signal(SIGINT, handleStopSignal);
+    signal(SIGTERM, handleStopSignal);
+
+    vector<thread> workers;
+    for (int t = 0; t < max(1, config.threads); t++)
+    {
+        workers.emplace_back(&GridServer::workerLoop, this);
+    }
+    cerr << "Serving on " << socketPath << " with " << workers.size() << " worker(s)" << endl;
+
+    while (!stopRequested)
+    {
+        // Wake up regularly so a stop signal is noticed even with no clients
+        pollfd waiting = {listener, POLLIN, 0};
+        if (poll(&waiting, 1, 200) <= 0)
+        {
+            continue;
+        }
+
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0)
+        {
+            continue;
+        }
+
+        {
+            lock_guard<mutex> lock(connectionMutex);
+            openConnections.insert(client);
+        }
+        {
+            lock_guard<mutex> lock(statsMutex);
+            connections++;
+        }
+        thread(&GridServer::serveConnection, this, client).detach();
+    }
+
+    // Stop accepting, wake every connection blocked on a read, and wait for them to finish
+    closeSocket(listener);
+    unlink(socketPath.c_str());
+    {
+        unique_lock<mutex> lock(connectionMutex);
+        for (int fd : openConnections)
+        {
+            shutdown(fd, SHUT_RDWR);
+        }
+        connectionsDone.wait(lock, [this] { return openConnections.empty(); });
+    }
+
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    return true;
+#else
+    listenUnixSocket(socketPath);  // Prints that sockets are not supported here
+    return false;
+#endif
+}
@@ -0,0 +1,91 @@
+/***************************************************************
+# server.h
+# Header for server.cpp, defines the GridServer socket server
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of GridServer class
+# 2026.10.2    16.10.2026   Limits on request line length, grid rows and grid columns
+****************************************************************/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include "batch.h"
+
+// Limits on what one client may send, so a single request cannot exhaust the server's memory
+static const size_t serverMaxLineBytes = 1 << 20;  // Longest request line or grid row; the connection is closed past it
+static const size_t serverMaxRows = 4096;          // Most rows in one SEARCH grid
+static const size_t serverMaxCols = 4096;          // Most cells in one grid row
+
+// GridServer class definition.
+// Keeps one loaded dictionary and answers grid searches over a Unix domain socket.
+// Each connection sends newline terminated requests and gets one JSON line back per request:
+//   SEARCH [name]   followed by the grid rows as CSV lines and an empty line;
+//                   answered with the same record batch mode writes for a grid,
+//                   or an error record for a grid over serverMaxRows or serverMaxCols
+//   STATS           request count, errors and p50/p90/p99/max latency in milliseconds
+//   QUIT            close the connection
+// Connections are read on their own threads; searches run on a fixed pool of
+// config.threads workers, so a burst of clients queues instead of oversubscribing.
+class GridServer
+{
+public:
+    GridServer(const BatchConfig& config, Trie* trie, const FlatTrie* flatTrie, const AhoCorasick* automaton, const std::set<std::string>& ignoreWords);
+
+    // Serve requests on socketPath until SIGINT or SIGTERM, then remove the socket file.
+    // Returns false if the socket could not be opened.
+    bool run(const std::string& socketPath);
+
+private:
+    // One search waiting for, or being run by, a worker
+    struct Job
+    {
+        std::string name;
+        std::vector<std::vector<char>> grid;
+        std::chrono::steady_clock::time_point received;  // When the request was fully read
+        std::promise<std::string> response;              // JSON record, set by the worker
+    };
+
+    void workerLoop();  // Take jobs off the queue until the server stops
+    void serveConnection(int fd);  // Read and answer requests until the client goes away
+    std::string statsRecord();  // JSON line for a STATS request
+
+    BatchConfig config;
+    Trie* trie;
+    const FlatTrie* flatTrie;
+    const AhoCorasick* automaton;
+    const std::set<std::string>& ignoreWords;
+
+    std::mutex queueMutex;                   // Guards queue, stopping and nextIndex
+    std::condition_variable queueReady;      // Signalled when a job is queued or the server stops
+    std::deque<Job*> queue;                  // Jobs waiting for a worker
+    bool stopping;                           // Set once the server is shutting down
+    uint64_t nextIndex;                      // Index given to the next search record
+
+    std::mutex connectionMutex;              // Guards openConnections
+    std::condition_variable connectionsDone; // Signalled when a connection thread ends
+    std::set<int> openConnections;           // Descriptors of connected clients
+
+    std::mutex statsMutex;                   // Guards the counters and latency window below
+    std::vector<double> latencies;           // Most recent request latencies in ms, used as a ring
+    size_t latencyNext;                      // Ring slot for the next latency
+    uint64_t requests;                       // Searches answered
+    uint64_t errors;                         // Malformed, oversized or unknown requests and unsearchable grids
+    uint64_t connections;                    // Connections accepted
+    std::chrono::steady_clock::time_point started;
+};
+
+#endif // SERVER_H
@@ -4,21 +4,29 @@
 # Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
 # This software is released under the MIT License.
 # See the LICENSE file in the project root for the full license text.
-# Last revised 16/10/2024
+# Last revised 16/10/2026
 #-----------------------------------------------------------------------
 # Version      Date         Notes:
 # 2024.10.0    15.10.2024   Initial implementation of Trie class
 # 2024.10.1    16.10.2024   Added recursive destructor to free all nodes,
 #                           handled case-insensitive search and prefix lookup.
+# 2026.10.1    15.10.2026   Count allocated nodes for memory reporting
+# 2026.10.2    16.10.2026   Number nodes in creation order
+# 2026.10.3    16.10.2026   Parallel insertChunks, one thread per first-letter subtrie
+# 2026.10.4    16.10.2026   Character class calls take unsigned char
 ****************************************************************/
 
 #include "trie.h"
 #include <cctype>  // For toupper
+#include <algorithm>  // For sort and min
+#include <atomic>
+#include <thread>
 
 // Constructor to initialize the root node of the Trie
 Trie::Trie()
 {
     root = new TrieNode();
+    nodes = 1;
 }
 
 // Destructor to clean up dynamically allocated memory (TrieNodes)
@@ -45,12 +53,13 @@ void Trie::insert(const string& word)
     for (char c : word)
     {
         // Check if the character is an alphabetic letter
-        if (isalpha(c))
+        if (isalpha(static_cast<unsigned char>(c)))
         {
-            int index = toupper(c) - 'A';  // Convert to uppercase and get index in range 0-25
+            int index = toupper(static_cast<unsigned char>(c)) - 'A';  // Convert to uppercase and get index in range 0-25
             if (node->children[index] == nullptr)
             {
                 node->children[index] = new TrieNode();
+                node->children[index]->id = static_cast<uint32_t>(nodes++);
             }
             node = node->children[index];
         }
@@ -63,14 +72,131 @@ void Trie::insert(const string& word)
     node->isEndOfWord = true;  // Mark the end of the word
 }
 
+// Run work(shard) for each of the 26 shards, in the given order, on up to threads threads
+template <typename Work>
+static void forEachShard(const int order[26], int threads, Work work)
+{
+    atomic<int> next(0);
+    auto worker = [&]()
+    {
+        for (int k = next++; k < 26; k = next++)
+        {
+            work(order[k]);
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < min(threads, 26); t++)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+}
+
+// Insert the words of chunks with one thread per first-letter subtrie, numbering nodes as insert would
+void Trie::insertChunks(const vector<TrieChunk>& chunks, int threads)
+{
+    // Position of each chunk's first word in the whole list, and the shard sizes
+    vector<size_t> chunkStart(chunks.size() + 1, 0);
+    size_t shardWords[26] = {};
+    for (size_t c = 0; c < chunks.size(); c++)
+    {
+        chunkStart[c + 1] = chunkStart[c] + chunks[c].words;
+        for (int s = 0; s < 26; s++)
+        {
+            shardWords[s] += chunks[c].ends[s].size();
+        }
+        if (chunks[c].letterless)
+        {
+            root->isEndOfWord = true;
+        }
+    }
+
+    // Largest shards first, so the last ones to start are small
+    int order[26];
+    for (int s = 0; s < 26; s++)
+    {
+        order[s] = s;
+    }
+    sort(order, order + 26, [&](int a, int b) { return shardWords[a] > shardWords[b]; });
+
+    // Build each shard under its root child. Only shard s's thread touches root->children[s]
+    // and the nodes below it. Each word's new nodes are noted in creation order.
+    vector<uint32_t> created(chunkStart.back(), 0);  // Nodes added by each word, in list order
+    vector<TrieNode*> shardNodes[26];                // New nodes of each shard, in creation order
+    forEachShard(order, threads, [&](int s)
+    {
+        vector<TrieNode*>& made = shardNodes[s];
+        for (size_t c = 0; c < chunks.size(); c++)
+        {
+            const TrieChunk& chunk = chunks[c];
+            const char* letters = chunk.letters[s].data();
+            uint32_t begin = 0;
+            for (size_t w = 0; w < chunk.ends[s].size(); w++)
+            {
+                size_t before = made.size();
+                TrieNode* node = root;
+                for (uint32_t p = begin; p < chunk.ends[s][w]; p++)
+                {
+                    int index = letters[p] - 'A';
+                    if (node->children[index] == nullptr)
+                    {
+                        node->children[index] = new TrieNode();
+                        made.push_back(node->children[index]);
+                    }
+                    node = node->children[index];
+                }
+                node->isEndOfWord = true;
+                created[chunkStart[c] + chunk.positions[s][w]] = static_cast<uint32_t>(made.size() - before);
+                begin = chunk.ends[s][w];
+            }
+        }
+    });
+
+    // A sequential build numbers nodes by the word that made them, then by depth.
+    // Turn each word's node count into the first id it would have handed out.
+    size_t id = nodes;
+    for (auto& count : created)
+    {
+        uint32_t first = static_cast<uint32_t>(id);
+        id += count;
+        count = first;
+    }
+    nodes = id;
+
+    // Walk each shard's words again in order, handing their nodes the ids from their first one on
+    forEachShard(order, threads, [&](int s)
+    {
+        const vector<TrieNode*>& made = shardNodes[s];
+        size_t taken = 0;
+        for (size_t c = 0; c < chunks.size(); c++)
+        {
+            const TrieChunk& chunk = chunks[c];
+            for (size_t w = 0; w < chunk.positions[s].size(); w++)
+            {
+                size_t word = chunkStart[c] + chunk.positions[s][w];
+                size_t end = word + 1 < created.size() ? created[word + 1] : id;
+                for (uint32_t next = created[word]; next < end; next++)
+                {
+                    made[taken++]->id = next;
+                }
+            }
+        }
+    });
+}
+
 // Search for a complete word in the Trie, handling both upper and lowercase input
 bool Trie::search(const string& word)
 {
     TrieNode* node = root;
     for (char c : word)
     {
-        if (!isalpha(c)) continue;  // Skip non-alphabetic characters
-        int index = toupper(c) - 'A';  // Convert to uppercase to handle case-insensitive search
+        if (!isalpha(static_cast<unsigned char>(c))) continue;  // Skip non-alphabetic characters
+        int index = toupper(static_cast<unsigned char>(c)) - 'A';  // Convert to uppercase to handle case-insensitive search
         if (index < 0 || index >= 26 || node->children[index] == nullptr)
         {
             return false;  // Word not found
@@ -86,8 +212,8 @@ bool Trie::startsWith(const string& prefix)
     TrieNode* node = root;
     for (char c : prefix)
     {
-        if (!isalpha(c)) continue;  // Skip non-alphabetic characters
-        int index = toupper(c) - 'A';  // Convert to uppercase to handle case-insensitive search
+        if (!isalpha(static_cast<unsigned char>(c))) continue;  // Skip non-alphabetic characters
+        int index = toupper(static_cast<unsigned char>(c)) - 'A';  // Convert to uppercase to handle case-insensitive search
         if (index < 0 || index >= 26 || node->children[index] == nullptr)
         {
             return false;  // Prefix not found
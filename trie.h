@@ -4,17 +4,22 @@
 # Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
 # This software is released under the MIT License.
 # See the LICENSE file in the project root for the full license text.
-# Last revised 16/10/2024
+# Last revised 16/10/2026
 #-----------------------------------------------------------------------
 # Version      Date         Notes:
 # 2024.10.0    15.10.2024   Initial implementation of Trie class
 # 2024.10.1    16.10.2024   Added recursive destructor to free all nodes
+# 2026.10.1    15.10.2026   Added node count and byte size accessors
+# 2026.10.2    16.10.2026   Added TrieNode id, the node's creation order
+# 2026.10.3    16.10.2026   Added insertChunks, building each first-letter subtrie on its own thread
 ****************************************************************/
 
 #ifndef TRIE_H
 #define TRIE_H
 
+#include <cstdint>
 #include <string>
+#include <vector>
 using namespace std;
 
 // TrieNode class definition
@@ -23,6 +28,7 @@ class TrieNode
 public:
     TrieNode* children[26];  // Pointers to child nodes for each alphabet letter
     bool isEndOfWord;
+    uint32_t id;  // Creation order, 0 for the root, so a search can keep per-node arrays; fits the padding
 
     TrieNode()
     {
@@ -31,9 +37,22 @@ public:
             children[i] = nullptr;
         }
         isEndOfWord = false;
+        id = 0;
     }
 };
 
+// TrieChunk structure, the words of one slice of a word list ready for Trie::insertChunks.
+// Words are grouped by shard, the index of their first letter, and hold only their
+// upper cased letters, as Trie::insert would walk them.
+struct TrieChunk
+{
+    std::vector<char> letters[26];       // Each shard's word letters, back to back
+    std::vector<uint32_t> ends[26];      // End of each of the shard's words in letters
+    std::vector<uint32_t> positions[26]; // Position of each of the shard's words among the chunk's words
+    uint32_t words = 0;                  // Words in the chunk, over every shard
+    bool letterless = false;             // A word with no letters, which marks the root as an end of word
+};
+
 // Trie class definition
 class Trie
 {
@@ -42,13 +61,25 @@ public:
     virtual ~Trie();   // Destructor that recursively frees all nodes
 
     void insert(const string& word);  // Insert word into Trie
+
+    // Insert the words of chunks, taken in chunk order. The subtrie under each of the root's
+    // 26 children is built by one thread, up to threads at a time, so no node is shared between
+    // threads. Node ids are then given out as if every word had been inserted one by one, making
+    // the trie identical to a sequential build.
+    void insertChunks(const std::vector<TrieChunk>& chunks, int threads);
+
     bool search(const string& word);  // Search for complete word in Trie
     bool startsWith(const string& prefix);  // Check if prefix exists in Trie
 
+    size_t nodeCount() const { return nodes; }  // Number of nodes including the root
+    size_t bytes() const { return nodes * sizeof(TrieNode); }  // Bytes held by the nodes, excluding allocator overhead
+
     TrieNode* root;  // Make the root public so it can be accessed by GridSearch
 
 private:
     void clearTrie(TrieNode* node);  // Helper function for recursive node deletion
+
+    size_t nodes;  // Number of allocated nodes
 };
 
 #endif // TRIE_H
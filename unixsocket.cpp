@@ -0,0 +1,219 @@
+/***************************************************************
+# unixsocket.cpp
+# Code implementing Unix domain socket helpers for the server and client
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of SocketStream and helpers
+# 2026.10.2    16.10.2026   readLine stops at a line longer than its limit
+****************************************************************/
+
+#include "unixsocket.h"
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifndef _WIN32
+
+// Fill in a socket address for path, returns false if the path is too long
+static bool makeAddress(const string& path, sockaddr_un& address)
+{
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        cerr << "Error: Socket path is too long: " << path << endl;
+        return false;
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+int listenUnixSocket(const string& path)
+{
+    sockaddr_un address;
+    if (!makeAddress(path, address))
+    {
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        cerr << "Error: Could not create socket: " << strerror(errno) << endl;
+        return -1;
+    }
+
+    unlink(path.c_str());  // A socket file left behind by an earlier server
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 128) != 0)
+    {
+        cerr << "Error: Could not listen on " << path << ": " << strerror(errno) << endl;
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int connectUnixSocket(const string& path)
+{
+    sockaddr_un address;
+    if (!makeAddress(path, address))
+    {
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void closeSocket(int fd)
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+}
+
+bool unixSocketsSupported()
+{
+    return true;
+}
+
+#else
+
+// Windows builds keep the interface but report that no socket could be opened
+int listenUnixSocket(const string& path)
+{
+    cerr << "Error: Unix domain sockets are not supported on this platform, cannot listen on " << path << endl;
+    return -1;
+}
+
+int connectUnixSocket(const string&)
+{
+    return -1;
+}
+
+void closeSocket(int)
+{
+}
+
+bool unixSocketsSupported()
+{
+    return false;
+}
+
+#endif
+
+// Constructor, takes ownership of a connected descriptor
+SocketStream::SocketStream(int fd)
+    : handle(fd), start(0), overlong(false)
+{
+}
+
+// Destructor, closes the descriptor
+SocketStream::~SocketStream()
+{
+    close();
+}
+
+void SocketStream::close()
+{
+    closeSocket(handle);
+    handle = -1;
+}
+
+// Return the next buffered line, receiving more bytes until a newline arrives
+bool SocketStream::readLine(string& line, size_t maxLength)
+{
+    for (;;)
+    {
+        size_t newline = buffer.find('\n', start);
+        if (newline != string::npos)
+        {
+            size_t end = newline;
+            if (end > start && buffer[end - 1] == '\r')
+            {
+                end--;
+            }
+            if (end - start > maxLength)
+            {
+                overlong = true;
+                return false;
+            }
+            line.assign(buffer, start, end - start);
+            start = newline + 1;
+            return true;
+        }
+
+        // Drop the lines already returned before reading more, and give up on a
+        // line that is already too long rather than buffering it without end
+        buffer.erase(0, start);
+        start = 0;
+        if (buffer.size() > maxLength && !(buffer.size() == maxLength + 1 && buffer.back() == '\r'))
+        {
+            overlong = true;
+            return false;
+        }
+
+#ifndef _WIN32
+        char chunk[65536];
+        ssize_t received = handle < 0 ? 0 : recv(handle, chunk, sizeof(chunk), 0);
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received <= 0)
+        {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(received));
+#else
+        return false;
+#endif
+    }
+}
+
+// Send the whole buffer, retrying partial writes
+bool SocketStream::writeAll(const string& data)
+{
+#ifndef _WIN32
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t written = handle < 0 ? -1 : send(handle, data.data() + sent, data.size() - sent, 0);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+#else
+    (void)data;
+    return false;
+#endif
+}
@@ -0,0 +1,64 @@
+/***************************************************************
+# unixsocket.h
+# Header for unixsocket.cpp, defines Unix domain socket helpers
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of SocketStream and helpers
+# 2026.10.2    16.10.2026   readLine takes a length limit
+****************************************************************/
+
+#ifndef UNIXSOCKET_H
+#define UNIXSOCKET_H
+
+#include <cstddef>
+#include <string>
+
+// Open a listening Unix domain socket at path, replacing a stale socket file.
+// Returns the socket descriptor, or -1 after printing an error.
+int listenUnixSocket(const std::string& path);
+
+// Connect to the Unix domain socket at path, returns the descriptor or -1
+int connectUnixSocket(const std::string& path);
+
+// Close a socket descriptor, ignoring -1
+void closeSocket(int fd);
+
+// True when Unix domain sockets are available on this platform
+bool unixSocketsSupported();
+
+// SocketStream class definition.
+// Line based reading and whole-buffer writing over a connected socket descriptor.
+// Owns the descriptor and closes it when destroyed. Not copyable.
+class SocketStream
+{
+public:
+    explicit SocketStream(int fd = -1);
+    ~SocketStream();
+
+    SocketStream(const SocketStream&) = delete;
+    SocketStream& operator=(const SocketStream&) = delete;
+
+    // Read one line without its line ending, returns false once the peer has closed.
+    // Also returns false, with lineTooLong() set, once a line runs past maxLength bytes;
+    // the stream is then out of step with the peer and should be closed.
+    bool readLine(std::string& line, size_t maxLength = std::string::npos);
+
+    // Write every byte of data, returns false if the peer has gone away
+    bool writeAll(const std::string& data);
+
+    int fd() const { return handle; }
+    bool lineTooLong() const { return overlong; }
+    void close();
+
+private:
+    int handle;          // Socket descriptor, -1 when closed
+    std::string buffer;  // Bytes received but not yet returned as lines
+    size_t start;        // Start of the unread part of buffer
+    bool overlong;       // A line ran past the limit given to readLine
+};
+
+#endif // UNIXSOCKET_H
@@ -0,0 +1,35 @@
+/***************************************************************
+# wordtable.cpp
+# Code implementing the WordTable used by all-occurrences searches
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of WordTable class
+****************************************************************/
+
+#include "wordtable.h"
+
+using namespace std;
+
+const uint32_t WordTable::npos;
+
+// Forget every word and size the key lookup, keeping the buffers for reuse
+void WordTable::reset(size_t keyCount)
+{
+    text.clear();
+    offsets.assign(1, 0);
+    ids.assign(keyCount, npos);
+}
+
+// Store a new word for key and return its id
+uint32_t WordTable::add(uint32_t key, const char* letters, size_t length)
+{
+    uint32_t id = static_cast<uint32_t>(size());
+    text.insert(text.end(), letters, letters + length);
+    offsets.push_back(text.size());
+    ids[key] = id;
+    return id;
+}
@@ -0,0 +1,65 @@
+/***************************************************************
+# wordtable.h
+# Header for wordtable.cpp, defines the compact all-occurrences result types
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial version of WordHit, WordTable and SearchResults
+# 2026.10.2    16.10.2026   Direction steps moved to the shared gridDx/gridDy in directions.h
+****************************************************************/
+
+#ifndef WORDTABLE_H
+#define WORDTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// WordHit structure, one occurrence of a word in the grid.
+// Plain data with no strings, so millions of hits are one flat allocation.
+// dir indexes gridDx/gridDy (directions.h); row and col are 0-based.
+struct WordHit
+{
+    uint32_t wordId;  // Index of the word in the WordTable
+    int32_t row;      // Start row
+    int32_t col;      // Start column
+    uint16_t dir;     // Direction index 0-7
+    uint16_t length;  // Letters in the word
+};
+
+// WordTable class definition.
+// Interns each distinct word once, keyed by its end-of-word trie node, and hands
+// out dense ids in the order words are first added. Text lives in one shared buffer.
+class WordTable
+{
+public:
+    static const uint32_t npos = UINT32_MAX;  // Returned by find for a key with no word
+
+    void reset(size_t keyCount);  // Forget every word and accept keys below keyCount
+    uint32_t find(uint32_t key) const { return ids[key]; }  // Id of the word stored for key, or npos
+    uint32_t add(uint32_t key, const char* letters, size_t length);  // Store a new word for key and return its id
+
+    size_t size() const { return offsets.size() - 1; }  // Number of distinct words
+    const char* data(uint32_t id) const { return text.data() + offsets[id]; }  // Letters of word id, not terminated
+    size_t length(uint32_t id) const { return offsets[id + 1] - offsets[id]; }  // Letters in word id
+    std::string word(uint32_t id) const { return std::string(data(id), length(id)); }  // Copy of word id
+
+private:
+    std::vector<char> text;        // Letters of every word, back to back
+    std::vector<size_t> offsets = std::vector<size_t>(1, 0);  // Start of each word in text, plus the end
+    std::vector<uint32_t> ids;     // Word id for each key, npos when none
+};
+
+// SearchResults structure, every occurrence found by an all-occurrences search.
+// Hits are in (row, col, direction, length) order, the order the DFS visits them.
+struct SearchResults
+{
+    std::vector<WordHit> hits;
+    WordTable words;
+};
+
+#endif // WORDTABLE_H
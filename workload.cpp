@@ -0,0 +1,213 @@
+/***************************************************************
+# workload.cpp
+# Code implementing the seeded synthetic grid and dictionary generator
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 16/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of the workload generator
+# 2026.10.2    15.10.2026   Added suffixShare, words ending on common English suffixes
+# 2026.10.3    16.10.2026   Direction and letter code tables come from directions.h
+****************************************************************/
+
+#include "workload.h"
+#include "directions.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+
+using namespace std;
+
+// Cumulative English letter frequencies (per 10000) for A to Z
+static const int letterCumulative[26] = {
+    817, 966, 1244, 1669, 2939, 3162, 3363, 3972, 4669, 4684, 4761, 5164, 5405,
+    6080, 6831, 7024, 7034, 7633, 8266, 9172, 9448, 9546, 9782, 9797, 9994, 10000
+};
+
+// splitmix64 step
+uint64_t WorkloadRng::next()
+{
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform value in [0, bound), the tiny modulo bias does not matter for workloads
+uint32_t WorkloadRng::below(uint32_t bound)
+{
+    return bound == 0 ? 0 : static_cast<uint32_t>(next() % bound);
+}
+
+// Uniform value in [0, 1) from the top 53 bits
+double WorkloadRng::unit()
+{
+    return static_cast<double>(next() >> 11) / 9007199254740992.0;
+}
+
+// Upper case letter drawn with English letter frequencies
+char WorkloadRng::letter()
+{
+    int roll = static_cast<int>(below(10000));
+    int index = static_cast<int>(upper_bound(letterCumulative, letterCumulative + 26, roll) - letterCumulative);
+    return static_cast<char>('A' + min(index, 25));
+}
+
+// Endings given to words with probability suffixShare
+static const char* commonSuffixes[] = {"S", "ES", "ED", "ER", "ERS", "ING", "INGS", "LY", "TION", "TIONS", "ATION", "MENT",
+                                       "MENTS", "NESS", "ABLE", "IBLE", "ITY", "IST", "ISM", "IZE", "IZED", "IZING", "FUL", "LESS"};
+
+// Generate distinct words, reusing earlier prefixes with probability prefixShare
+// and ending on a common suffix with probability suffixShare
+vector<string> generateWords(size_t wordCount, double prefixShare, int minLength, int maxLength, uint64_t seed, double suffixShare)
+{
+    WorkloadRng rng(seed);
+    vector<string> words;
+    unordered_set<string> seen;
+    words.reserve(wordCount);
+    seen.reserve(wordCount * 2);
+
+    minLength = max(minLength, 1);
+    maxLength = max(maxLength, minLength);
+    size_t attempts = 0;
+
+    while (words.size() < wordCount && attempts < wordCount * 50 + 1000)
+    {
+        attempts++;
+        int length = minLength + static_cast<int>(rng.below(static_cast<uint32_t>(maxLength - minLength + 1)));
+        string word;
+
+        if (!words.empty() && rng.unit() < prefixShare)
+        {
+            // Start from part of an earlier word so the two share a trie branch
+            const string& donor = words[rng.below(static_cast<uint32_t>(words.size()))];
+            size_t keep = 1 + rng.below(static_cast<uint32_t>(donor.size()));
+            word = donor.substr(0, min(keep, static_cast<size_t>(length)));
+        }
+        while (static_cast<int>(word.size()) < length)
+        {
+            word += rng.letter();
+        }
+        if (suffixShare > 0 && rng.unit() < suffixShare)
+        {
+            // End on a common English suffix, so whole word endings repeat across the dictionary
+            const char* suffix = commonSuffixes[rng.below(sizeof(commonSuffixes) / sizeof(commonSuffixes[0]))];
+            size_t stem = max(static_cast<size_t>(1), word.size() > strlen(suffix) ? word.size() - strlen(suffix) : 1);
+            word = word.substr(0, stem) + suffix;
+        }
+
+        if (seen.insert(word).second)
+        {
+            words.push_back(word);
+        }
+    }
+
+    return words;
+}
+
+// Generate a random letter grid and plant words along random straight lines
+vector<vector<char>> generateGrid(int rows, int cols, const vector<string>& words, size_t plantCount, uint64_t seed)
+{
+    WorkloadRng rng(seed);
+    vector<vector<char>> grid(rows, vector<char>(cols));
+
+    for (auto& row : grid)
+    {
+        for (auto& cell : row)
+        {
+            cell = rng.letter();
+        }
+    }
+
+    if (words.empty() || rows <= 0 || cols <= 0)
+    {
+        return grid;
+    }
+
+    for (size_t p = 0; p < plantCount; p++)
+    {
+        const string& word = words[rng.below(static_cast<uint32_t>(words.size()))];
+        int len = static_cast<int>(word.size());
+        int d = static_cast<int>(rng.below(8));
+
+        // Pick a start cell from which the whole word stays inside the grid
+        int minX = gridDx[d] < 0 ? len - 1 : 0;
+        int maxX = gridDx[d] > 0 ? rows - len : rows - 1;
+        int minY = gridDy[d] < 0 ? len - 1 : 0;
+        int maxY = gridDy[d] > 0 ? cols - len : cols - 1;
+        if (minX > maxX || minY > maxY)
+        {
+            continue;  // Word longer than the grid in this direction
+        }
+
+        int x = minX + static_cast<int>(rng.below(static_cast<uint32_t>(maxX - minX + 1)));
+        int y = minY + static_cast<int>(rng.below(static_cast<uint32_t>(maxY - minY + 1)));
+        for (int k = 0; k < len; k++)
+        {
+            grid[x + k * gridDx[d]][y + k * gridDy[d]] = word[k];
+        }
+    }
+
+    return grid;
+}
+
+// Write a grid as comma separated rows
+bool writeGridCSV(const string& filename, const vector<vector<char>>& grid)
+{
+    ofstream file(filename, ios::binary | ios::trunc);
+    if (!file.is_open())
+    {
+        cerr << "Error: Could not create grid file " << filename << endl;
+        return false;
+    }
+
+    string line;
+    for (const auto& row : grid)
+    {
+        line.clear();
+        for (size_t j = 0; j < row.size(); j++)
+        {
+            if (j > 0)
+            {
+                line += ',';
+            }
+            line += row[j];
+        }
+        line += '\n';
+        file.write(line.data(), line.size());
+    }
+
+    file.close();
+    return static_cast<bool>(file);
+}
+
+// Write words as comma separated lines of up to 16 words
+bool writeWordsCSV(const string& filename, const vector<string>& words)
+{
+    ofstream file(filename, ios::binary | ios::trunc);
+    if (!file.is_open())
+    {
+        cerr << "Error: Could not create words file " << filename << endl;
+        return false;
+    }
+
+    string line;
+    for (size_t i = 0; i < words.size(); i++)
+    {
+        line += words[i];
+        line += (i % 16 == 15 || i + 1 == words.size()) ? '\n' : ',';
+        if (line.size() > 65536)
+        {
+            file.write(line.data(), line.size());
+            line.clear();
+        }
+    }
+    file.write(line.data(), line.size());
+
+    file.close();
+    return static_cast<bool>(file);
+}
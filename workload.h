@@ -0,0 +1,55 @@
+/***************************************************************
+# workload.h
+# Header for workload.cpp, seeded generator for synthetic grids and dictionaries
+# Copyright (C) 2024 C. Brown (dev@coralesoft.nz)
+# This software is released under the MIT License.
+# See the LICENSE file in the project root for the full license text.
+# Last revised 15/10/2026
+#-----------------------------------------------------------------------
+# Version      Date         Notes:
+# 2026.10.1    15.10.2026   Initial implementation of the workload generator
+# 2026.10.2    15.10.2026   Added suffixShare, words ending on common English suffixes
+****************************************************************/
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// WorkloadRng class definition.
+// Small splitmix64 generator, so a seed produces the same workload with every
+// compiler and standard library (std:: distributions are not portable).
+class WorkloadRng
+{
+public:
+    explicit WorkloadRng(uint64_t seed) : state(seed) {}
+
+    uint64_t next();  // Next 64-bit value
+    uint32_t below(uint32_t bound);  // Uniform value in [0, bound)
+    double unit();  // Uniform value in [0, 1)
+    char letter();  // Upper case letter drawn with English letter frequencies
+
+private:
+    uint64_t state;
+};
+
+// Generate wordCount distinct upper case words of minLength to maxLength letters.
+// prefixShare is the chance (0 to 1) that a word reuses the prefix of an earlier word,
+// which controls how much the dictionary's trie branches are shared. suffixShare is the
+// chance that a word ends on a common English suffix (-ING, -TION, -ED, ...), which
+// controls how many word endings a minimised dictionary can merge.
+std::vector<std::string> generateWords(size_t wordCount, double prefixShare, int minLength, int maxLength, uint64_t seed, double suffixShare = 0);
+
+// Generate a rows x cols grid of letters and plant up to plantCount of the words
+// in random positions and directions so the search has real hits.
+std::vector<std::vector<char>> generateGrid(int rows, int cols, const std::vector<std::string>& words, size_t plantCount, uint64_t seed);
+
+// Write a grid in the CSV format read by readCSVFile, returns false on I/O failure
+bool writeGridCSV(const std::string& filename, const std::vector<std::vector<char>>& grid);
+
+// Write words in the CSV format read by loadWordsFromCSVFile, returns false on I/O failure
+bool writeWordsCSV(const std::string& filename, const std::vector<std::string>& words);
+
+#endif // WORKLOAD_H